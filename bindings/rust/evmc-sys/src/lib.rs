@@ -40,4 +40,10 @@ mod tests {
         assert_eq!(size_of::<evmc_address>(), 20);
         assert!(size_of::<evmc_vm>() <= 64);
     }
+
+    #[test]
+    fn abi_version() {
+        // The ABI version must be bumped together with every change of the C API layout.
+        assert_eq!(EVMC_ABI_VERSION, 13);
+    }
 }
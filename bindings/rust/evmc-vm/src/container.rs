@@ -158,6 +158,7 @@ mod tests {
             access_storage: None,
             get_transient_storage: None,
             set_transient_storage: None,
+            allocate_output: None,
         };
         let host_context = std::ptr::null_mut();
 
@@ -8,6 +8,7 @@
 #include "example_host.h"
 
 #include <evmc/evmc.hpp>
+#include <evmc/keccak.hpp>
 
 #include <algorithm>
 #include <map>
@@ -28,11 +29,7 @@ struct account
 
     virtual evmc::bytes32 code_hash() const
     {
-        // Extremely dumb "hash" function.
-        evmc::bytes32 ret{};
-        for (const auto v : code)
-            ret.bytes[v % sizeof(ret.bytes)] ^= v;
-        return ret;
+        return evmc::keccak256({code.data(), code.size()});
     }
 };
 
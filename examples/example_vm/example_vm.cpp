@@ -353,7 +353,8 @@ evmc_result execute(evmc_vm* instance,
             if (output_ptr == nullptr)
                 return evmc_make_result(EVMC_FAILURE, 0, 0, nullptr, 0);
 
-            return evmc_make_result(EVMC_SUCCESS, gas_left, 0, output_ptr, output_size);
+            return evmc_make_host_result(host, context, EVMC_SUCCESS, gas_left, 0, output_ptr,
+                                         output_size);
         }
 
         case OP_REVERT:
@@ -367,7 +368,8 @@ evmc_result execute(evmc_vm* instance,
             if (output_ptr == nullptr)
                 return evmc_make_result(EVMC_FAILURE, 0, 0, nullptr, 0);
 
-            return evmc_make_result(EVMC_REVERT, gas_left, 0, output_ptr, output_size);
+            return evmc_make_host_result(host, context, EVMC_REVERT, gas_left, 0, output_ptr,
+                                         output_size);
         }
         }
     }
@@ -3,6 +3,7 @@
 // Licensed under the Apache License, Version 2.0.
 #pragma once
 
+#include <evmc/platform.hpp>
 #include <algorithm>
 #include <cstring>
 #include <string>
@@ -12,6 +13,10 @@ namespace evmc
 {
 /// The char traits for byte-like types.
 ///
+/// At runtime the operations on byte ranges are dispatched to the C library functions
+/// (memcmp, memchr, memmove, memcpy, memset) which are vectorized by the standard library
+/// implementations. The byte loops are kept for constant evaluation.
+///
 /// See: https://en.cppreference.com/w/cpp/string/char_traits.
 template <typename T>
 struct byte_traits : std::char_traits<char>
@@ -26,7 +31,14 @@ struct byte_traits : std::char_traits<char>
     /// Assigns value to each byte in [ptr, ptr+count).
     static constexpr char_type* assign(char_type* ptr, std::size_t count, char_type value)
     {
-        std::fill_n(ptr, count, value);
+        if (!detail::is_constant_evaluated())
+        {
+            if (count != 0)
+                std::memset(ptr, static_cast<int>(value), count);
+            return ptr;
+        }
+        for (std::size_t i = 0; i < count; ++i)
+            ptr[i] = value;
         return ptr;
     }
 
@@ -39,23 +51,44 @@ struct byte_traits : std::char_traits<char>
     /// Copies count bytes from src to dest. Performs correctly even if ranges overlap.
     static constexpr char_type* move(char_type* dest, const char_type* src, std::size_t count)
     {
+        if (!detail::is_constant_evaluated())
+        {
+            if (count != 0)
+                std::memmove(dest, src, count);
+            return dest;
+        }
         if (dest < src)
-            std::copy_n(src, count, dest);
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                dest[i] = src[i];
+        }
         else if (src < dest)
-            std::copy_backward(src, src + count, dest + count);
+        {
+            for (std::size_t i = count; i != 0; --i)
+                dest[i - 1] = src[i - 1];
+        }
         return dest;
     }
 
     /// Copies count bytes from src to dest. The ranges must not overlap.
     static constexpr char_type* copy(char_type* dest, const char_type* src, std::size_t count)
     {
-        std::copy_n(src, count, dest);
+        if (!detail::is_constant_evaluated())
+        {
+            if (count != 0)
+                std::memcpy(dest, src, count);
+            return dest;
+        }
+        for (std::size_t i = 0; i < count; ++i)
+            dest[i] = src[i];
         return dest;
     }
 
     /// Compares lexicographically the bytes in two ranges of equal length.
     static constexpr int compare(const char_type* a, const char_type* b, std::size_t count)
     {
+        if (!detail::is_constant_evaluated())
+            return count != 0 ? std::memcmp(a, b, count) : 0;
         for (; count != 0; --count, ++a, ++b)
         {
             if (lt(*a, *b))
@@ -79,9 +112,18 @@ struct byte_traits : std::char_traits<char>
                                            std::size_t count,
                                            const char_type& value)
     {
-        const auto end = s + count;
-        const auto p = std::find(s, end, value);
-        return p != end ? p : nullptr;
+        if (!detail::is_constant_evaluated())
+        {
+            if (count == 0)
+                return nullptr;
+            return static_cast<const char_type*>(std::memchr(s, static_cast<int>(value), count));
+        }
+        for (; count != 0; --count, ++s)
+        {
+            if (eq(*s, value))
+                return s;
+        }
+        return nullptr;
     }
 };
 
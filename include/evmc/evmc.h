@@ -44,7 +44,7 @@ enum
      *
      * @see @ref versioning
      */
-    EVMC_ABI_VERSION = 12
+    EVMC_ABI_VERSION = 13
 };
 
 
@@ -473,6 +473,12 @@ struct evmc_result
      * @note
      * It works similarly to C++ virtual destructor. Attaching the release
      * function to the result itself allows VM composition.
+     *
+     * The release function MUST NOT depend on evmc_result::status_code,
+     * evmc_result::gas_left and evmc_result::gas_refund. This allows transferring
+     * the ownership of the output without copying: a VM MAY keep the result of a call
+     * as its return data buffer and later return it as its own result with these fields
+     * replaced. The result is then released once, by its final owner.
      */
     evmc_release_result_fn release;
 
@@ -834,6 +840,25 @@ typedef enum evmc_access_status (*evmc_access_storage_fn)(struct evmc_host_conte
 typedef struct evmc_result (*evmc_call_fn)(struct evmc_host_context* context,
                                            const struct evmc_message* msg);
 
+/**
+ * Allocate output callback function.
+ *
+ * This callback function is used by a VM to allocate the memory for the output
+ * of an execution result (evmc_result::output_data) or for other buffers
+ * like the return data of a call from the memory managed by the Host,
+ * e.g. an arena released at once when the transaction is finished.
+ *
+ * The memory is owned by the Host and remains valid at least until the end of the
+ * transaction. The VM MUST NOT free it, so the evmc_result::release of the result
+ * using this memory for the output MUST NOT attempt to free the output.
+ *
+ * @param context  The Host execution context.
+ * @param size     The size of the memory to allocate in bytes. Greater than 0.
+ * @return         The pointer to the allocated memory or NULL if the Host cannot provide it.
+ *                 In the latter case the VM SHOULD use its own memory allocation.
+ */
+typedef uint8_t* (*evmc_allocate_output_fn)(struct evmc_host_context* context, size_t size);
+
 /**
  * The Host interface.
  *
@@ -891,6 +916,13 @@ struct evmc_host_interface
 
     /** Set transient storage callback function. */
     evmc_set_transient_storage_fn set_transient_storage;
+
+    /**
+     * Allocate output callback function.
+     *
+     * This callback function is optional and MAY be NULL.
+     */
+    evmc_allocate_output_fn allocate_output;
 };
 
 
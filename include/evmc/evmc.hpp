@@ -6,7 +6,9 @@
 #include <evmc/evmc.h>
 #include <evmc/helpers.h>
 #include <evmc/hex.hpp>
+#include <evmc/platform.hpp>
 
+#include <cstring>
 #include <functional>
 #include <initializer_list>
 #include <ostream>
@@ -124,9 +126,83 @@ struct bytes32 : evmc_bytes32
 using uint256be = bytes32;
 
 
+namespace detail
+{
+/// Loads the value of type T from the possibly unaligned @p data in the native byte order.
+template <typename T>
+inline T load_unaligned(const uint8_t* data) noexcept
+{
+    T v;
+    std::memcpy(&v, data, sizeof(v));
+    return v;
+}
+
+/// Reverses the order of bytes of the 64-bit value.
+inline uint64_t bswap(uint64_t x) noexcept
+{
+#if defined(_MSC_VER)
+    return _byteswap_uint64(x);
+#else
+    return __builtin_bswap64(x);
+#endif
+}
+
+/// Reverses the order of bytes of the 32-bit value.
+inline uint32_t bswap(uint32_t x) noexcept
+{
+#if defined(_MSC_VER)
+    return _byteswap_ulong(x);
+#else
+    return __builtin_bswap32(x);
+#endif
+}
+/// The 128-bit product of 64-bit values split into the 64-bit halves.
+struct umul_result
+{
+    uint64_t hi;  ///< The high half.
+    uint64_t lo;  ///< The low half.
+};
+
+#if defined(_MSC_VER) && defined(_M_X64)
+inline umul_result umul_runtime(uint64_t a, uint64_t b) noexcept
+{
+    umul_result r{};
+    r.lo = _umul128(a, b, &r.hi);
+    return r;
+}
+#endif
+
+/// Computes the full 128-bit product of the 64-bit values.
+inline constexpr umul_result umul(uint64_t a, uint64_t b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ using uint128 = unsigned __int128;
+    const auto p = uint128{a} * b;
+    return {static_cast<uint64_t>(p >> 64), static_cast<uint64_t>(p)};
+#else
+#if defined(_MSC_VER) && defined(_M_X64)
+    if (use_runtime_impl())
+        return umul_runtime(a, b);
+#endif
+    const auto al = a & 0xffffffff;
+    const auto ah = a >> 32;
+    const auto bl = b & 0xffffffff;
+    const auto bh = b >> 32;
+    const auto ll = al * bl;
+    const auto lh = al * bh;
+    const auto hl = ah * bl;
+    const auto hh = ah * bh;
+    const auto mid = (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+    return {hh + (lh >> 32) + (hl >> 32) + (mid >> 32), (mid << 32) | (ll & 0xffffffff)};
+#endif
+}
+}  // namespace detail
+
 /// Loads 64 bits / 8 bytes of data from the given @p data array in big-endian order.
 inline constexpr uint64_t load64be(const uint8_t* data) noexcept
 {
+    if (detail::use_runtime_impl())
+        return detail::bswap(detail::load_unaligned<uint64_t>(data));
     return (uint64_t{data[0]} << 56) | (uint64_t{data[1]} << 48) | (uint64_t{data[2]} << 40) |
            (uint64_t{data[3]} << 32) | (uint64_t{data[4]} << 24) | (uint64_t{data[5]} << 16) |
            (uint64_t{data[6]} << 8) | uint64_t{data[7]};
@@ -135,6 +211,8 @@ inline constexpr uint64_t load64be(const uint8_t* data) noexcept
 /// Loads 64 bits / 8 bytes of data from the given @p data array in little-endian order.
 inline constexpr uint64_t load64le(const uint8_t* data) noexcept
 {
+    if (detail::use_runtime_impl())
+        return detail::load_unaligned<uint64_t>(data);
     return uint64_t{data[0]} | (uint64_t{data[1]} << 8) | (uint64_t{data[2]} << 16) |
            (uint64_t{data[3]} << 24) | (uint64_t{data[4]} << 32) | (uint64_t{data[5]} << 40) |
            (uint64_t{data[6]} << 48) | (uint64_t{data[7]} << 56);
@@ -143,6 +221,8 @@ inline constexpr uint64_t load64le(const uint8_t* data) noexcept
 /// Loads 32 bits / 4 bytes of data from the given @p data array in big-endian order.
 inline constexpr uint32_t load32be(const uint8_t* data) noexcept
 {
+    if (detail::use_runtime_impl())
+        return detail::bswap(detail::load_unaligned<uint32_t>(data));
     return (uint32_t{data[0]} << 24) | (uint32_t{data[1]} << 16) | (uint32_t{data[2]} << 8) |
            uint32_t{data[3]};
 }
@@ -150,10 +230,196 @@ inline constexpr uint32_t load32be(const uint8_t* data) noexcept
 /// Loads 32 bits / 4 bytes of data from the given @p data array in little-endian order.
 inline constexpr uint32_t load32le(const uint8_t* data) noexcept
 {
+    if (detail::use_runtime_impl())
+        return detail::load_unaligned<uint32_t>(data);
     return uint32_t{data[0]} | (uint32_t{data[1]} << 8) | (uint32_t{data[2]} << 16) |
            (uint32_t{data[3]} << 24);
 }
 
+namespace detail
+{
+// The runtime implementations of the comparisons of N-byte arrays, where N is 20 or 32.
+// The bytes [16:20] of the address are handled as the 32-bit "tail".
+
+#if defined(EVMC_SIMD_SSE2)
+/// Returns the index of the lowest set bit of the non-zero @p x.
+inline unsigned ctz(uint32_t x) noexcept
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, x);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(x));
+#endif
+}
+
+/// Loads 16 bytes.
+inline __m128i load128(const uint8_t* data) noexcept
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+/// Loads 4 bytes to the lowest lane, zeroing the rest.
+inline __m128i load128_tail(const uint8_t* data) noexcept
+{
+    return _mm_cvtsi32_si128(load_unaligned<int>(data));
+}
+
+/// Loads the bytes [16:N].
+template <size_t N>
+inline __m128i load128_hi(const uint8_t* data) noexcept
+{
+    return N == 32 ? load128(data + 16) : load128_tail(data + 16);
+}
+
+/// The mask of all N bytes equal.
+template <size_t N>
+inline constexpr uint32_t all_equal_mask = N == 32 ? 0xffffffff : 0xfffff;
+
+/// Returns the bit mask of the equal bytes, the bit i is set if a[i] == b[i].
+template <size_t N>
+inline uint32_t equal_mask(const uint8_t* a, const uint8_t* b) noexcept
+{
+    static_assert(N == 20 || N == 32);
+#if defined(EVMC_SIMD_AVX2)
+    if constexpr (N == 32)
+    {
+        const auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+        const auto y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+    }
+#endif
+    const auto lo = _mm_movemask_epi8(_mm_cmpeq_epi8(load128(a), load128(b)));
+    const auto hi = _mm_movemask_epi8(_mm_cmpeq_epi8(load128_hi<N>(a), load128_hi<N>(b)));
+    return (static_cast<uint32_t>(lo) | (static_cast<uint32_t>(hi) << 16)) & all_equal_mask<N>;
+}
+
+template <size_t N>
+inline bool equal(const uint8_t* a, const uint8_t* b) noexcept
+{
+    return equal_mask<N>(a, b) == all_equal_mask<N>;
+}
+
+/// Compares the bytes at the first position where the arrays differ.
+template <size_t N>
+inline bool less(const uint8_t* a, const uint8_t* b) noexcept
+{
+    const auto diff = equal_mask<N>(a, b) ^ all_equal_mask<N>;
+    if (diff == 0)
+        return false;
+    const auto i = ctz(diff);
+    return a[i] < b[i];
+}
+
+template <size_t N>
+inline bool is_zero(const uint8_t* data) noexcept
+{
+#if defined(EVMC_SIMD_AVX2)
+    if constexpr (N == 32)
+    {
+        const auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        return _mm256_testz_si256(x, x) != 0;
+    }
+#endif
+    const auto x = _mm_or_si128(load128(data), load128_hi<N>(data));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_setzero_si128())) == 0xffff;
+}
+
+/// The key loaded to registers once to be compared with many other keys.
+template <size_t N>
+class KeyMatcher
+{
+    __m128i m_lo;
+    __m128i m_hi;
+
+public:
+    explicit KeyMatcher(const uint8_t* key) noexcept : m_lo{load128(key)}, m_hi{load128_hi<N>(key)}
+    {}
+
+    bool operator()(const uint8_t* data) const noexcept
+    {
+        const auto eq = _mm_and_si128(_mm_cmpeq_epi8(m_lo, load128(data)),
+                                      _mm_cmpeq_epi8(m_hi, load128_hi<N>(data)));
+        return _mm_movemask_epi8(eq) == 0xffff;
+    }
+};
+
+#else
+
+template <size_t N>
+inline bool equal(const uint8_t* a, const uint8_t* b) noexcept
+{
+    static_assert(N == 20 || N == 32);
+#if defined(EVMC_SIMD_NEON)
+    const auto lo = vceqq_u8(vld1q_u8(a), vld1q_u8(b));
+    if constexpr (N == 32)
+        return vminvq_u8(vandq_u8(lo, vceqq_u8(vld1q_u8(a + 16), vld1q_u8(b + 16)))) == 0xff;
+    else
+    {
+        return vminvq_u8(lo) == 0xff &&
+               load_unaligned<uint32_t>(a + 16) == load_unaligned<uint32_t>(b + 16);
+    }
+#else
+    uint64_t diff = 0;
+    for (size_t i = 0; i + 8 <= N; i += 8)
+        diff |= load_unaligned<uint64_t>(a + i) ^ load_unaligned<uint64_t>(b + i);
+    if constexpr (N % 8 != 0)
+        diff |= load_unaligned<uint32_t>(a + N - 4) ^ load_unaligned<uint32_t>(b + N - 4);
+    return diff == 0;
+#endif
+}
+
+/// Compares the big-endian 64-bit words (and the 32-bit tail).
+template <size_t N>
+inline bool less(const uint8_t* a, const uint8_t* b) noexcept
+{
+    for (size_t i = 0; i + 8 <= N; i += 8)
+    {
+        const auto x = bswap(load_unaligned<uint64_t>(a + i));
+        const auto y = bswap(load_unaligned<uint64_t>(b + i));
+        if (x != y)
+            return x < y;
+    }
+    if constexpr (N % 8 != 0)
+        return bswap(load_unaligned<uint32_t>(a + 16)) < bswap(load_unaligned<uint32_t>(b + 16));
+    else
+        return false;
+}
+
+template <size_t N>
+inline bool is_zero(const uint8_t* data) noexcept
+{
+#if defined(EVMC_SIMD_NEON)
+    const auto lo = vld1q_u8(data);
+    if constexpr (N == 32)
+        return vmaxvq_u8(vorrq_u8(lo, vld1q_u8(data + 16))) == 0;
+    else
+        return vmaxvq_u8(lo) == 0 && load_unaligned<uint32_t>(data + 16) == 0;
+#else
+    uint64_t x = 0;
+    for (size_t i = 0; i + 8 <= N; i += 8)
+        x |= load_unaligned<uint64_t>(data + i);
+    if constexpr (N % 8 != 0)
+        x |= load_unaligned<uint32_t>(data + N - 4);
+    return x == 0;
+#endif
+}
+
+/// The key to be compared with many other keys.
+template <size_t N>
+class KeyMatcher
+{
+    const uint8_t* m_key;
+
+public:
+    explicit KeyMatcher(const uint8_t* key) noexcept : m_key{key} {}
+
+    bool operator()(const uint8_t* data) const noexcept { return equal<N>(m_key, data); }
+};
+#endif
+}  // namespace detail
+
 namespace fnv
 {
 constexpr auto prime = 0x100000001b3;              ///< The 64-bit FNV prime number.
@@ -166,10 +432,26 @@ inline constexpr uint64_t fnv1a_by64(uint64_t h, uint64_t x) noexcept
 }
 }  // namespace fnv
 
+namespace wyhash
+{
+/// The wyhash secret constants.
+constexpr uint64_t secret[]{0x2d358dccaa6c78a5, 0x8bb84b93962eacc9, 0x4b33a62ed433d4a3,
+                            0x4d5a2da51de1aa47};
+
+/// The wyhash mixing function: the 128-bit product of the inputs folded to 64 bits by XOR.
+inline constexpr uint64_t mix(uint64_t a, uint64_t b) noexcept
+{
+    const auto p = detail::umul(a, b);
+    return p.lo ^ p.hi;
+}
+}  // namespace wyhash
+
 
 /// The "equal to" comparison operator for the evmc::address type.
 inline constexpr bool operator==(const address& a, const address& b) noexcept
 {
+    if (detail::use_runtime_impl())
+        return detail::equal<sizeof(a)>(a.bytes, b.bytes);
     return load64le(&a.bytes[0]) == load64le(&b.bytes[0]) &&
            load64le(&a.bytes[8]) == load64le(&b.bytes[8]) &&
            load32le(&a.bytes[16]) == load32le(&b.bytes[16]);
@@ -184,6 +466,8 @@ inline constexpr bool operator!=(const address& a, const address& b) noexcept
 /// The "less than" comparison operator for the evmc::address type.
 inline constexpr bool operator<(const address& a, const address& b) noexcept
 {
+    if (detail::use_runtime_impl())
+        return detail::less<sizeof(a)>(a.bytes, b.bytes);
     return load64be(&a.bytes[0]) < load64be(&b.bytes[0]) ||
            (load64be(&a.bytes[0]) == load64be(&b.bytes[0]) &&
             (load64be(&a.bytes[8]) < load64be(&b.bytes[8]) ||
@@ -212,6 +496,8 @@ inline constexpr bool operator>=(const address& a, const address& b) noexcept
 /// The "equal to" comparison operator for the evmc::bytes32 type.
 inline constexpr bool operator==(const bytes32& a, const bytes32& b) noexcept
 {
+    if (detail::use_runtime_impl())
+        return detail::equal<sizeof(a)>(a.bytes, b.bytes);
     return load64le(&a.bytes[0]) == load64le(&b.bytes[0]) &&
            load64le(&a.bytes[8]) == load64le(&b.bytes[8]) &&
            load64le(&a.bytes[16]) == load64le(&b.bytes[16]) &&
@@ -227,6 +513,8 @@ inline constexpr bool operator!=(const bytes32& a, const bytes32& b) noexcept
 /// The "less than" comparison operator for the evmc::bytes32 type.
 inline constexpr bool operator<(const bytes32& a, const bytes32& b) noexcept
 {
+    if (detail::use_runtime_impl())
+        return detail::less<sizeof(a)>(a.bytes, b.bytes);
     return load64be(&a.bytes[0]) < load64be(&b.bytes[0]) ||
            (load64be(&a.bytes[0]) == load64be(&b.bytes[0]) &&
             (load64be(&a.bytes[8]) < load64be(&b.bytes[8]) ||
@@ -257,6 +545,8 @@ inline constexpr bool operator>=(const bytes32& a, const bytes32& b) noexcept
 /// Checks if the given address is the zero address.
 inline constexpr bool is_zero(const address& a) noexcept
 {
+    if (detail::use_runtime_impl())
+        return detail::is_zero<sizeof(a)>(a.bytes);
     return a == address{};
 }
 
@@ -268,6 +558,8 @@ inline constexpr address::operator bool() const noexcept
 /// Checks if the given bytes32 object has all zero bytes.
 inline constexpr bool is_zero(const bytes32& a) noexcept
 {
+    if (detail::use_runtime_impl())
+        return detail::is_zero<sizeof(a)>(a.bytes);
     return a == bytes32{};
 }
 
@@ -276,6 +568,104 @@ inline constexpr bytes32::operator bool() const noexcept
     return !is_zero(*this);
 }
 
+namespace detail
+{
+template <typename T>
+inline size_t find_equal_runtime(const T& key, const T* keys, size_t n) noexcept
+{
+    const KeyMatcher<sizeof(T)> match{key.bytes};
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (match(keys[i].bytes))
+            return i;
+    }
+    return n;
+}
+
+template <typename T>
+inline constexpr size_t find_equal(const T& key, const T* keys, size_t n) noexcept
+{
+    if (use_runtime_impl())
+        return find_equal_runtime(key, keys, n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (keys[i] == key)
+            return i;
+    }
+    return n;
+}
+}  // namespace detail
+
+/// Finds the first of the @p n @p keys equal to the @p key.
+///
+/// This is the batched variant of operator== for linear probing:
+/// the searched key is loaded once for all comparisons.
+///
+/// @return  The index of the found key or @p n if not found.
+inline constexpr size_t find_equal(const address& key, const address* keys, size_t n) noexcept
+{
+    return detail::find_equal(key, keys, n);
+}
+
+/// Finds the first of the @p n @p keys equal to the @p key.
+///
+/// @copydetails find_equal(const address&, const address*, size_t)
+inline constexpr size_t find_equal(const bytes32& key, const bytes32* keys, size_t n) noexcept
+{
+    return detail::find_equal(key, keys, n);
+}
+
+/// The fast, high-quality hash function for evmc::address and evmc::bytes32 keys.
+///
+/// Every input bit affects every output bit (unlike in the FNV-based std::hash specializations),
+/// so also structured keys, e.g. small sequential storage slots, are distributed well
+/// in containers with power-of-two number of buckets. It is based on the wyhash mixing function:
+/// the 64-bit words of a key are mixed pairwise with 64x64->128-bit multiplications.
+///
+/// Use it as the Hash template argument of unordered containers, e.g.
+/// `std::unordered_map<evmc::address, Account, evmc::fast_hash>`.
+struct fast_hash
+{
+    /// Hash operator for evmc::address.
+    constexpr size_t operator()(const address& a) const noexcept
+    {
+        using namespace wyhash;
+        const auto h = mix(load64le(&a.bytes[0]) ^ secret[0], load64le(&a.bytes[8]) ^ secret[1]);
+        return static_cast<size_t>(
+            mix(h ^ secret[1] ^ sizeof(a), load32le(&a.bytes[16]) ^ secret[2]));
+    }
+
+    /// Hash operator for evmc::bytes32.
+    constexpr size_t operator()(const bytes32& b) const noexcept
+    {
+        using namespace wyhash;
+        const auto h1 = mix(load64le(&b.bytes[0]) ^ secret[0], load64le(&b.bytes[8]) ^ secret[1]);
+        const auto h2 = mix(load64le(&b.bytes[16]) ^ secret[2], load64le(&b.bytes[24]) ^ secret[3]);
+        return static_cast<size_t>(mix(h1 ^ secret[1] ^ sizeof(b), h2 ^ secret[1]));
+    }
+};
+
+/// The hash function for keys which are already uniformly distributed hash values,
+/// e.g. Keccak-256 outputs such as the storage keys of Solidity mappings.
+///
+/// The hash value is the last 8 bytes of the key in big-endian order. Small sequential keys
+/// are therefore mapped to distinct consecutive hash values. Keys having the last 8 bytes
+/// equal collide, so only use it for the keys not controlled by an adversary.
+struct prehashed_hash
+{
+    /// Hash operator for evmc::address.
+    constexpr size_t operator()(const address& a) const noexcept
+    {
+        return static_cast<size_t>(load64be(&a.bytes[sizeof(a) - 8]));
+    }
+
+    /// Hash operator for evmc::bytes32.
+    constexpr size_t operator()(const bytes32& b) const noexcept
+    {
+        return static_cast<size_t>(load64be(&b.bytes[sizeof(b) - 8]));
+    }
+};
+
 namespace literals
 {
 /// Converts a raw literal into value of type T.
@@ -411,6 +801,31 @@ public:
         return *this;
     }
 
+    /// Returns the view of the output.
+    bytes_view output() const noexcept { return {output_data, output_size}; }
+
+    /// Moves the output of this result to the new result of the given status, without copying.
+    ///
+    /// This allows a VM to adopt the result of a call as its return data buffer and then
+    /// forward it up the call stack as its own output. The create_address is kept as it
+    /// belongs to the optional storage of the release function.
+    /// See evmc_result::release for the requirements on the release functions.
+    ///
+    /// @param _status_code  The status code of the new result.
+    /// @param _gas_left     The amount of gas left of the new result.
+    /// @param _gas_refund   The amount of refunded gas of the new result.
+    /// @return              The new result owning the output of this one.
+    Result forward(evmc_status_code _status_code,
+                   int64_t _gas_left,
+                   int64_t _gas_refund) && noexcept
+    {
+        Result result{std::move(*this)};
+        result.status_code = _status_code;
+        result.gas_left = _gas_left;
+        result.gas_refund = _gas_refund;
+        return result;
+    }
+
     /// Access the result object as a referenced to ::evmc_result.
     evmc_result& raw() noexcept { return *this; }
 
@@ -499,6 +914,11 @@ public:
     virtual void set_transient_storage(const address& addr,
                                        const bytes32& key,
                                        const bytes32& value) noexcept = 0;
+
+    /// @copydoc evmc_allocate_output_fn
+    ///
+    /// Optional, the default implementation provides no memory.
+    virtual uint8_t* allocate_output([[maybe_unused]] size_t size) noexcept { return nullptr; }
 };
 
 
@@ -609,6 +1029,24 @@ public:
     {
         host->set_transient_storage(context, &address, &key, &value);
     }
+
+    uint8_t* allocate_output(size_t size) noexcept final
+    {
+        return host->allocate_output != nullptr ? host->allocate_output(context, size) : nullptr;
+    }
+
+    /// Creates the result with the output copied to the memory provided by the Host.
+    ///
+    /// See evmc_make_host_result().
+    Result make_result(evmc_status_code status_code,
+                       int64_t gas_left,
+                       int64_t gas_refund,
+                       const uint8_t* output_data,
+                       size_t output_size) noexcept
+    {
+        return Result{evmc_make_host_result(host, context, status_code, gas_left, gas_refund,
+                                            output_data, output_size)};
+    }
 };
 
 
@@ -877,6 +1315,11 @@ inline void set_transient_storage(evmc_host_context* h,
 {
     Host::from_context(h)->set_transient_storage(*addr, *key, *value);
 }
+
+inline uint8_t* allocate_output(evmc_host_context* h, size_t size) noexcept
+{
+    return Host::from_context(h)->allocate_output(size);
+}
 }  // namespace internal
 
 inline const evmc_host_interface& Host::get_interface() noexcept
@@ -898,6 +1341,7 @@ inline const evmc_host_interface& Host::get_interface() noexcept
         ::evmc::internal::access_storage,
         ::evmc::internal::get_transient_storage,
         ::evmc::internal::set_transient_storage,
+        ::evmc::internal::allocate_output,
     };
     return interface;
 }
@@ -0,0 +1,674 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+/// @file
+/// The open-addressing hash map with the elements stored in a flat array.
+#pragma once
+
+#include <evmc/platform.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace evmc
+{
+namespace detail
+{
+/// The control byte of a flat_map slot. For the full slots it is the 7-bit fragment
+/// of the key's hash (H2), the special values are negative.
+using ctrl_t = int8_t;
+
+inline constexpr ctrl_t ctrl_empty = -128;   ///< The slot is empty.
+inline constexpr ctrl_t ctrl_deleted = -2;   ///< The slot held an element which has been erased.
+inline constexpr ctrl_t ctrl_sentinel = -1;  ///< The end of the control bytes, stops iterators.
+
+/// The set of slots in a group, iterated from the lowest index.
+class GroupMask
+{
+#if defined(EVMC_SIMD_NEON)
+    /// The log2 of the number of bits representing a slot in the mask.
+    static constexpr unsigned shift = 2;
+#else
+    /// The log2 of the number of bits representing a slot in the mask.
+    static constexpr unsigned shift = 0;
+#endif
+
+    uint64_t m_mask;
+
+public:
+    /// Constructs the set from the bit mask.
+    explicit constexpr GroupMask(uint64_t mask) noexcept : m_mask{mask} {}
+
+    /// Returns true if the set is not empty.
+    explicit constexpr operator bool() const noexcept { return m_mask != 0; }
+
+    /// Returns the index of the lowest slot in the non-empty set.
+    unsigned lowest() const noexcept
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, m_mask);
+        return static_cast<unsigned>(index) >> shift;
+#else
+        return static_cast<unsigned>(__builtin_ctzll(m_mask)) >> shift;
+#endif
+    }
+
+    /// Removes the lowest slot from the set.
+    void clear_lowest() noexcept { m_mask &= m_mask - 1; }
+};
+
+/// The group of control bytes probed together, with SIMD instructions where available.
+class Group
+{
+#if defined(EVMC_SIMD_SSE2)
+    __m128i m_ctrl;
+#elif defined(EVMC_SIMD_NEON)
+    int8x16_t m_ctrl;
+
+    /// Converts the result of the vector comparison to the mask having 1 bit of 4 set per slot.
+    static uint64_t to_mask(uint8x16_t v) noexcept
+    {
+        const auto nibbles = vshrn_n_u16(vreinterpretq_u16_u8(v), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888;
+    }
+#else
+    ctrl_t m_ctrl[16];
+#endif
+
+public:
+    /// The number of slots in a group.
+    static constexpr size_t width = 16;
+
+    /// Loads the group of control bytes.
+    explicit Group(const ctrl_t* ctrl) noexcept
+    {
+#if defined(EVMC_SIMD_SSE2)
+        m_ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#elif defined(EVMC_SIMD_NEON)
+        m_ctrl = vld1q_s8(ctrl);
+#else
+        for (size_t i = 0; i < width; ++i)
+            m_ctrl[i] = ctrl[i];
+#endif
+    }
+
+    /// Returns the slots having the given control byte.
+    GroupMask match(ctrl_t c) const noexcept
+    {
+#if defined(EVMC_SIMD_SSE2)
+        const auto eq = _mm_cmpeq_epi8(m_ctrl, _mm_set1_epi8(c));
+        return GroupMask{static_cast<uint16_t>(_mm_movemask_epi8(eq))};
+#elif defined(EVMC_SIMD_NEON)
+        return GroupMask{to_mask(vceqq_s8(m_ctrl, vdupq_n_s8(c)))};
+#else
+        uint64_t mask = 0;
+        for (size_t i = 0; i < width; ++i)
+            mask |= uint64_t{m_ctrl[i] == c} << i;
+        return GroupMask{mask};
+#endif
+    }
+
+    /// Returns the empty slots.
+    GroupMask match_empty() const noexcept { return match(ctrl_empty); }
+
+    /// Returns the empty and deleted slots, i.e. the slots available for insertion.
+    GroupMask match_free() const noexcept
+    {
+#if defined(EVMC_SIMD_SSE2)
+        // The special control bytes in a group have the highest bit set.
+        return GroupMask{static_cast<uint16_t>(_mm_movemask_epi8(m_ctrl))};
+#elif defined(EVMC_SIMD_NEON)
+        return GroupMask{to_mask(vcltzq_s8(m_ctrl))};
+#else
+        uint64_t mask = 0;
+        for (size_t i = 0; i < width; ++i)
+            mask |= uint64_t{m_ctrl[i] < 0} << i;
+        return GroupMask{mask};
+#endif
+    }
+};
+}  // namespace detail
+
+/// The hash map with open addressing, in the style of the "Swiss tables".
+///
+/// The elements are stored in a single flat array of slots. Every slot has a control byte
+/// holding 7 bits of the key's hash. The slots are probed in groups of 16: the control bytes
+/// of a group are compared with the hash fragment at once (with SSE2 or NEON instructions)
+/// and only the keys of the matching slots are compared. The table is grown to keep the load
+/// factor under 7/8. The erased slots are marked as deleted unless no probe sequence
+/// could have passed them.
+///
+/// The interface is a subset of the std::unordered_map one. Differences:
+/// - the insertions (and the rehashing) invalidate all iterators and references
+///   to the elements,
+/// - emplace() takes the key and the arguments of the mapped value constructor,
+/// - the Hash must distribute the keys over all bits of the hash value (e.g. evmc::fast_hash),
+///   because the low bits select the group and the high bits are stored in the control bytes.
+template <typename Key,
+          typename T,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class flat_map
+{
+public:
+    using key_type = Key;                        ///< The key type.
+    using mapped_type = T;                       ///< The mapped value type.
+    using value_type = std::pair<const Key, T>;  ///< The element type.
+    using size_type = size_t;                    ///< The size type.
+    using difference_type = ptrdiff_t;           ///< The iterator difference type.
+    using hasher = Hash;                         ///< The hash function type.
+    using key_equal = KeyEqual;                  ///< The key equality function type.
+    using reference = value_type&;               ///< The element reference type.
+    using const_reference = const value_type&;   ///< The element const reference type.
+
+private:
+    using ctrl_t = detail::ctrl_t;
+    using Group = detail::Group;
+
+    /// The iterator over the full slots.
+    template <bool Const>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;  ///< The iterator category.
+        using value_type = flat_map::value_type;              ///< The element type.
+        using difference_type = ptrdiff_t;                    ///< The difference type.
+        /// The element pointer type.
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+        /// The element reference type.
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+    private:
+        friend class flat_map;
+        friend class Iterator<!Const>;
+
+        const ctrl_t* m_ctrl = nullptr;
+        value_type* m_slot = nullptr;
+
+        Iterator(const ctrl_t* ctrl, value_type* slot) noexcept : m_ctrl{ctrl}, m_slot{slot} {}
+
+        /// Advances to the first full slot or to the sentinel.
+        void skip_free() noexcept
+        {
+            while (*m_ctrl < detail::ctrl_sentinel)
+            {
+                ++m_ctrl;
+                ++m_slot;
+            }
+        }
+
+    public:
+        /// Default constructor.
+        Iterator() noexcept = default;
+
+        /// Converts the iterator to the const iterator.
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        Iterator(const Iterator<false>& other) noexcept  // NOLINT(hicpp-explicit-conversions)
+          : m_ctrl{other.m_ctrl}, m_slot{other.m_slot}
+        {}
+
+        /// Returns the reference to the element.
+        reference operator*() const noexcept { return *m_slot; }
+
+        /// Returns the pointer to the element.
+        pointer operator->() const noexcept { return m_slot; }
+
+        /// Advances to the next element.
+        Iterator& operator++() noexcept
+        {
+            ++m_ctrl;
+            ++m_slot;
+            skip_free();
+            return *this;
+        }
+
+        /// Advances to the next element and returns the previous iterator value.
+        Iterator operator++(int) noexcept
+        {
+            auto prev = *this;
+            ++*this;
+            return prev;
+        }
+
+        /// Equal operator.
+        friend bool operator==(const Iterator& a, const Iterator& b) noexcept
+        {
+            return a.m_ctrl == b.m_ctrl;
+        }
+
+        /// Not-equal operator.
+        friend bool operator!=(const Iterator& a, const Iterator& b) noexcept { return !(a == b); }
+    };
+
+public:
+    using iterator = Iterator<false>;       ///< The iterator type.
+    using const_iterator = Iterator<true>;  ///< The const iterator type.
+
+private:
+    /// The control bytes: a byte per slot followed by the sentinel.
+    ctrl_t* m_ctrl = nullptr;
+
+    /// The slots. The elements are constructed only in the full slots.
+    value_type* m_slots = nullptr;
+
+    /// The number of slots: a power of 2 multiple of the group width or 0.
+    size_t m_capacity = 0;
+
+    /// The number of elements.
+    size_t m_size = 0;
+
+    /// The number of empty slots which can be filled before the table must be rehashed.
+    size_t m_growth_left = 0;
+
+    Hash m_hash;
+    KeyEqual m_key_eq;
+
+    /// Returns the maximum number of elements (and deleted slots) in the table of the capacity.
+    static constexpr size_t max_load(size_t capacity) noexcept { return capacity - capacity / 8; }
+
+    /// Returns the 7-bit fragment of the hash stored in the control byte.
+    static constexpr ctrl_t h2(size_t hash) noexcept { return static_cast<ctrl_t>(hash & 0x7f); }
+
+    /// Calls the function with the index of each group in the probe sequence of the hash
+    /// until the function returns true. The triangular probing visits all the groups.
+    template <typename F>
+    void probe(size_t hash, F f) const
+    {
+        const auto num_groups_mask = m_capacity / Group::width - 1;
+        auto group = (hash >> 7) & num_groups_mask;
+        for (size_t step = 1; !f(group * Group::width); ++step)
+            group = (group + step) & num_groups_mask;
+    }
+
+    /// Returns the index of the slot with the key or the capacity if not found.
+    size_t find_index(const key_type& key, size_t hash) const
+    {
+        if (m_capacity == 0)
+            return 0;
+
+        auto index = m_capacity;
+        probe(hash, [&](size_t base) {
+            const Group group{&m_ctrl[base]};
+            for (auto m = group.match(h2(hash)); m; m.clear_lowest())
+            {
+                const auto i = base + m.lowest();
+                if (m_key_eq(m_slots[i].first, key))
+                {
+                    index = i;
+                    return true;
+                }
+            }
+            // The key would have been inserted in this group.
+            return static_cast<bool>(group.match_empty());
+        });
+        return index;
+    }
+
+    /// Returns the index of the first empty or deleted slot in the probe sequence of the hash.
+    size_t find_free(size_t hash) const noexcept
+    {
+        size_t index = 0;
+        probe(hash, [&](size_t base) {
+            const auto m = Group{&m_ctrl[base]}.match_free();
+            if (m)
+                index = base + m.lowest();
+            return static_cast<bool>(m);
+        });
+        return index;
+    }
+
+    /// Allocates the table of the given capacity with all slots empty.
+    void allocate(size_t capacity)
+    {
+        auto ctrl = std::make_unique<ctrl_t[]>(capacity + 1);
+        m_slots = std::allocator<value_type>{}.allocate(capacity);
+        m_ctrl = ctrl.release();
+        std::fill_n(m_ctrl, capacity, detail::ctrl_empty);
+        m_ctrl[capacity] = detail::ctrl_sentinel;
+        m_capacity = capacity;
+        m_growth_left = max_load(capacity) - m_size;
+    }
+
+    /// Destroys the elements in the full slots.
+    void destroy_elements() noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<value_type>)
+        {
+            for (size_t i = 0; i < m_capacity; ++i)
+            {
+                if (m_ctrl[i] >= 0)
+                    m_slots[i].~value_type();
+            }
+        }
+    }
+
+    /// Destroys the elements and releases the table.
+    void destroy() noexcept
+    {
+        if (m_capacity == 0)
+            return;
+        destroy_elements();
+        std::allocator<value_type>{}.deallocate(m_slots, m_capacity);
+        delete[] m_ctrl;
+    }
+
+    /// Moves the elements to the new table of the given capacity.
+    void rehash(size_t capacity)
+    {
+        const auto old_ctrl = m_ctrl;
+        const auto old_slots = m_slots;
+        const auto old_capacity = m_capacity;
+        allocate(capacity);
+
+        for (size_t i = 0; i < old_capacity; ++i)
+        {
+            if (old_ctrl[i] < 0)
+                continue;
+            const auto hash = m_hash(old_slots[i].first);
+            const auto j = find_free(hash);
+            new (&m_slots[j]) value_type{std::move(old_slots[i])};
+            old_slots[i].~value_type();
+            m_ctrl[j] = h2(hash);
+        }
+        m_growth_left = max_load(m_capacity) - m_size;
+
+        if (old_capacity != 0)
+        {
+            std::allocator<value_type>{}.deallocate(old_slots, old_capacity);
+            delete[] old_ctrl;
+        }
+    }
+
+    /// Returns the index of the slot for inserting the new element with the hash.
+    /// Rehashes the table if there is no room for the element.
+    size_t prepare_insert(size_t hash)
+    {
+        if (m_growth_left == 0)
+        {
+            // Rehash without growing if the most of the load are the deleted slots.
+            const auto grow = m_capacity == 0 || m_size > max_load(m_capacity) / 2;
+            rehash(grow ? std::max(2 * m_capacity, Group::width) : m_capacity);
+        }
+        return find_free(hash);
+    }
+
+    /// Marks the slot with the newly constructed element as full.
+    void finish_insert(size_t index, size_t hash) noexcept
+    {
+        if (m_ctrl[index] == detail::ctrl_empty)
+            --m_growth_left;
+        m_ctrl[index] = h2(hash);
+        ++m_size;
+    }
+
+    /// Erases the element in the full slot.
+    void erase_at(size_t index) noexcept
+    {
+        m_slots[index].~value_type();
+        --m_size;
+
+        // No probe sequence has passed the group with an empty slot,
+        // so the slot can be marked as empty instead of deleted.
+        const auto base = index & ~(Group::width - 1);
+        if (Group{&m_ctrl[base]}.match_empty())
+        {
+            m_ctrl[index] = detail::ctrl_empty;
+            ++m_growth_left;
+        }
+        else
+            m_ctrl[index] = detail::ctrl_deleted;
+    }
+
+    iterator iterator_at(size_t index) noexcept { return {m_ctrl + index, m_slots + index}; }
+
+    const_iterator iterator_at(size_t index) const noexcept
+    {
+        return {m_ctrl + index, m_slots + index};
+    }
+
+public:
+    /// Default constructor. Does not allocate.
+    flat_map() = default;
+
+    /// Copy constructor.
+    flat_map(const flat_map& other) : m_hash{other.m_hash}, m_key_eq{other.m_key_eq}
+    {
+        reserve(other.size());
+        for (const auto& [key, value] : other)
+            try_emplace(key, value);
+    }
+
+    /// Move constructor. Leaves the other map empty.
+    flat_map(flat_map&& other) noexcept
+      : m_ctrl{std::exchange(other.m_ctrl, nullptr)},
+        m_slots{std::exchange(other.m_slots, nullptr)},
+        m_capacity{std::exchange(other.m_capacity, 0)},
+        m_size{std::exchange(other.m_size, 0)},
+        m_growth_left{std::exchange(other.m_growth_left, 0)},
+        m_hash{other.m_hash},
+        m_key_eq{other.m_key_eq}
+    {}
+
+    /// Constructs the map with the elements from the range [first, last).
+    template <typename InputIt>
+    flat_map(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+            insert(*first);
+    }
+
+    /// Constructs the map with the elements from the initializer list.
+    flat_map(std::initializer_list<value_type> init) : flat_map(init.begin(), init.end()) {}
+
+    /// Copy assignment.
+    flat_map& operator=(const flat_map& other)
+    {
+        if (this != &other)
+        {
+            flat_map copy{other};
+            swap(copy);
+        }
+        return *this;
+    }
+
+    /// Move assignment.
+    flat_map& operator=(flat_map&& other) noexcept
+    {
+        flat_map moved{std::move(other)};
+        swap(moved);
+        return *this;
+    }
+
+    /// Destructor.
+    ~flat_map() { destroy(); }
+
+    /// Swaps the contents with the other map.
+    void swap(flat_map& other) noexcept
+    {
+        using std::swap;
+        swap(m_ctrl, other.m_ctrl);
+        swap(m_slots, other.m_slots);
+        swap(m_capacity, other.m_capacity);
+        swap(m_size, other.m_size);
+        swap(m_growth_left, other.m_growth_left);
+        swap(m_hash, other.m_hash);
+        swap(m_key_eq, other.m_key_eq);
+    }
+
+    /// Swaps the contents of the maps.
+    friend void swap(flat_map& a, flat_map& b) noexcept { a.swap(b); }
+
+    /// Returns the iterator to the first element.
+    iterator begin() noexcept
+    {
+        if (m_size == 0)
+            return end();
+        auto it = iterator_at(0);
+        it.skip_free();
+        return it;
+    }
+
+    /// Returns the iterator to the first element.
+    const_iterator begin() const noexcept
+    {
+        if (m_size == 0)
+            return end();
+        auto it = iterator_at(0);
+        it.skip_free();
+        return it;
+    }
+
+    /// Returns the iterator past the last element.
+    iterator end() noexcept { return iterator_at(m_capacity); }
+
+    /// Returns the iterator past the last element.
+    const_iterator end() const noexcept { return iterator_at(m_capacity); }
+
+    /// Returns the iterator to the first element.
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    /// Returns the iterator past the last element.
+    const_iterator cend() const noexcept { return end(); }
+
+    /// Returns true if the map has no elements.
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+    /// Returns the number of elements.
+    size_t size() const noexcept { return m_size; }
+
+    /// Returns the number of slots in the table.
+    size_t capacity() const noexcept { return m_capacity; }
+
+    /// Returns the hash function.
+    hasher hash_function() const { return m_hash; }
+
+    /// Returns the key equality function.
+    key_equal key_eq() const { return m_key_eq; }
+
+    /// Erases all elements. Keeps the allocated table.
+    void clear() noexcept
+    {
+        if (m_capacity == 0)
+            return;
+        destroy_elements();
+        std::fill_n(m_ctrl, m_capacity, detail::ctrl_empty);
+        m_size = 0;
+        m_growth_left = max_load(m_capacity);
+    }
+
+    /// Grows the table so that the given number of elements can be inserted without rehashing.
+    void reserve(size_t count)
+    {
+        if (max_load(m_capacity) >= count)
+            return;
+        auto capacity = std::max(m_capacity, Group::width);
+        while (max_load(capacity) < count)
+            capacity *= 2;
+        rehash(capacity);
+    }
+
+    /// Inserts the element constructed from the arguments if the key is not present.
+    ///
+    /// @return  The iterator to the element with the key and true if the element was inserted.
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+    {
+        const auto hash = m_hash(key);
+        if (const auto i = find_index(key, hash); i != m_capacity)
+            return {iterator_at(i), false};
+
+        const auto i = prepare_insert(hash);
+        new (&m_slots[i]) value_type{std::piecewise_construct, std::forward_as_tuple(key),
+                                     std::forward_as_tuple(std::forward<Args>(args)...)};
+        finish_insert(i, hash);
+        return {iterator_at(i), true};
+    }
+
+    /// Inserts the element constructed from the arguments if the key is not present.
+    /// Same as try_emplace().
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(const key_type& key, Args&&... args)
+    {
+        return try_emplace(key, std::forward<Args>(args)...);
+    }
+
+    /// Inserts the copy of the element if its key is not present.
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return try_emplace(value.first, value.second);
+    }
+
+    /// Returns the reference to the value mapped to the key.
+    /// Inserts the value-initialized element if the key is not present.
+    T& operator[](const key_type& key) { return try_emplace(key).first->second; }
+
+    /// Returns the reference to the value mapped to the key.
+    /// @throws std::out_of_range  If the key is not present.
+    T& at(const key_type& key)
+    {
+        const auto it = find(key);
+        if (it == end())
+            throw std::out_of_range{"flat_map::at"};
+        return it->second;
+    }
+
+    /// Returns the reference to the value mapped to the key.
+    /// @throws std::out_of_range  If the key is not present.
+    const T& at(const key_type& key) const
+    {
+        const auto it = find(key);
+        if (it == end())
+            throw std::out_of_range{"flat_map::at"};
+        return it->second;
+    }
+
+    /// Returns the iterator to the element with the key or end() if not found.
+    iterator find(const key_type& key) { return iterator_at(find_index(key, m_hash(key))); }
+
+    /// Returns the iterator to the element with the key or end() if not found.
+    const_iterator find(const key_type& key) const
+    {
+        return iterator_at(find_index(key, m_hash(key)));
+    }
+
+    /// Returns the number of elements with the key, i.e. 1 or 0.
+    size_t count(const key_type& key) const { return find(key) != end() ? 1 : 0; }
+
+    /// Erases the element with the key.
+    /// @return  The number of erased elements, i.e. 1 or 0.
+    size_t erase(const key_type& key)
+    {
+        const auto i = find_index(key, m_hash(key));
+        if (i == m_capacity)
+            return 0;
+        erase_at(i);
+        return 1;
+    }
+
+    /// Erases the element at the iterator position.
+    /// @return  The iterator to the element following the erased one.
+    iterator erase(const_iterator pos) noexcept
+    {
+        const auto i = static_cast<size_t>(pos.m_slot - m_slots);
+        erase_at(i);
+        auto it = iterator_at(i);
+        it.skip_free();
+        return it;
+    }
+
+    /// Erases the element at the iterator position.
+    /// @return  The iterator to the element following the erased one.
+    iterator erase(iterator pos) noexcept { return erase(const_iterator{pos}); }
+};
+}  // namespace evmc
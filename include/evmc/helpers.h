@@ -155,6 +155,46 @@ static inline struct evmc_result evmc_make_result(enum evmc_status_code status_c
     return result;
 }
 
+/// Creates the result with the output copied to the memory provided by the Host.
+///
+/// If the Host implements evmc_host_interface::allocate_output the output is copied
+/// to the memory allocated by the Host and evmc_result::release is not set.
+/// Otherwise, or if the Host allocation fails, this works as evmc_make_result().
+///
+/// @param host         The Host interface. MAY be NULL.
+/// @param context      The Host execution context.
+/// @param status_code  The status code.
+/// @param gas_left     The amount of gas left.
+/// @param gas_refund   The amount of refunded gas.
+/// @param output_data  The pointer to the output.
+/// @param output_size  The output size.
+static inline struct evmc_result evmc_make_host_result(const struct evmc_host_interface* host,
+                                                       struct evmc_host_context* context,
+                                                       enum evmc_status_code status_code,
+                                                       int64_t gas_left,
+                                                       int64_t gas_refund,
+                                                       const uint8_t* output_data,
+                                                       size_t output_size)
+{
+    if (output_size != 0 && host != NULL && host->allocate_output != NULL)
+    {
+        uint8_t* buffer = host->allocate_output(context, output_size);
+        if (buffer)
+        {
+            struct evmc_result result;
+            memset(&result, 0, sizeof(result));
+            memcpy(buffer, output_data, output_size);
+            result.status_code = status_code;
+            result.gas_left = gas_left;
+            result.gas_refund = gas_refund;
+            result.output_data = buffer;
+            result.output_size = output_size;
+            return result;
+        }
+    }
+    return evmc_make_result(status_code, gas_left, gas_refund, output_data, output_size);
+}
+
 /**
  * Releases the resources allocated to the execution result.
  *
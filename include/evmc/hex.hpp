@@ -5,6 +5,7 @@
 
 #include <evmc/bytes.hpp>
 #include <evmc/filter_iterator.hpp>
+#include <evmc/platform.hpp>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -19,16 +20,6 @@ inline std::string hex(uint8_t b) noexcept
     return {hex_digits[b >> 4], hex_digits[b & 0xf]};
 }
 
-/// Encodes bytes as hex string.
-inline std::string hex(bytes_view bs)
-{
-    std::string str;
-    str.reserve(bs.size() * 2);
-    for (const auto b : bs)
-        str += hex(b);
-    return str;
-}
-
 namespace internal
 {
 /// Extracts the nibble value out of a hex digit.
@@ -44,8 +35,219 @@ inline constexpr int from_hex_digit(char h) noexcept
     else
         return -1;
 }
+
+// The hex encoding and decoding kernels. The SIMD variants process the blocks of 16 or 32 bytes
+// and leave the remainder to the scalar loop. The nibbles are mapped to the digits arithmetically:
+// the digits '0'-'9' and the letters 'a'-'f' (or 'A'-'F') are two contiguous ranges.
+
+#if defined(EVMC_SIMD_SSE2)
+/// Converts the nibbles to the lowercase hex digits.
+inline __m128i hex_digits(__m128i n) noexcept
+{
+    const auto letter = _mm_cmpgt_epi8(n, _mm_set1_epi8(9));
+    const auto d = _mm_add_epi8(n, _mm_set1_epi8('0'));
+    return _mm_add_epi8(d, _mm_and_si128(letter, _mm_set1_epi8('a' - '0' - 10)));
+}
+
+/// Converts the hex digits to the nibbles. The invalid digits clear the bytes of @p valid.
+inline __m128i hex_nibbles(__m128i c, __m128i& valid) noexcept
+{
+    const auto d = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    const auto is_digit = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+    const auto lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    const auto l = _mm_sub_epi8(lower, _mm_set1_epi8('a'));
+    const auto is_letter = _mm_cmpeq_epi8(_mm_min_epu8(l, _mm_set1_epi8(5)), l);
+    valid = _mm_and_si128(valid, _mm_or_si128(is_digit, is_letter));
+    return _mm_or_si128(_mm_and_si128(is_digit, d),
+                        _mm_and_si128(is_letter, _mm_add_epi8(l, _mm_set1_epi8(10))));
+}
+
+/// Combines the pairs of nibbles (high first) into the bytes in the 16-bit lanes.
+inline __m128i hex_combine(__m128i n) noexcept
+{
+    const auto hi = _mm_slli_epi16(_mm_and_si128(n, _mm_set1_epi16(0x00ff)), 4);
+    return _mm_or_si128(hi, _mm_srli_epi16(n, 8));
+}
+#endif
+
+#if defined(EVMC_SIMD_AVX2)
+/// @copydoc hex_digits(__m128i)
+inline __m256i hex_digits(__m256i n) noexcept
+{
+    const auto letter = _mm256_cmpgt_epi8(n, _mm256_set1_epi8(9));
+    const auto d = _mm256_add_epi8(n, _mm256_set1_epi8('0'));
+    return _mm256_add_epi8(d, _mm256_and_si256(letter, _mm256_set1_epi8('a' - '0' - 10)));
+}
+
+/// @copydoc hex_nibbles(__m128i, __m128i&)
+inline __m256i hex_nibbles(__m256i c, __m256i& valid) noexcept
+{
+    const auto d = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+    const auto is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+    const auto lower = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+    const auto l = _mm256_sub_epi8(lower, _mm256_set1_epi8('a'));
+    const auto is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(l, _mm256_set1_epi8(5)), l);
+    valid = _mm256_and_si256(valid, _mm256_or_si256(is_digit, is_letter));
+    return _mm256_or_si256(_mm256_and_si256(is_digit, d),
+                           _mm256_and_si256(is_letter, _mm256_add_epi8(l, _mm256_set1_epi8(10))));
+}
+
+/// @copydoc hex_combine(__m128i)
+inline __m256i hex_combine(__m256i n) noexcept
+{
+    const auto hi = _mm256_slli_epi16(_mm256_and_si256(n, _mm256_set1_epi16(0x00ff)), 4);
+    return _mm256_or_si256(hi, _mm256_srli_epi16(n, 8));
+}
+#endif
+
+#if defined(EVMC_SIMD_NEON)
+/// Converts the nibbles to the lowercase hex digits.
+inline uint8x16_t hex_digits(uint8x16_t n) noexcept
+{
+    const auto letter = vcgtq_u8(n, vdupq_n_u8(9));
+    const auto d = vaddq_u8(n, vdupq_n_u8('0'));
+    return vaddq_u8(d, vandq_u8(letter, vdupq_n_u8('a' - '0' - 10)));
+}
+
+/// Converts the hex digits to the nibbles. The invalid digits clear the bytes of @p valid.
+inline uint8x16_t hex_nibbles(uint8x16_t c, uint8x16_t& valid) noexcept
+{
+    const auto d = vsubq_u8(c, vdupq_n_u8('0'));
+    const auto is_digit = vcleq_u8(d, vdupq_n_u8(9));
+    const auto lower = vorrq_u8(c, vdupq_n_u8(0x20));
+    const auto l = vsubq_u8(lower, vdupq_n_u8('a'));
+    const auto is_letter = vcleq_u8(l, vdupq_n_u8(5));
+    valid = vandq_u8(valid, vorrq_u8(is_digit, is_letter));
+    return vbslq_u8(is_digit, d, vaddq_u8(l, vdupq_n_u8(10)));
+}
+#endif
+
+/// Encodes the @p size bytes as 2 * @p size hex digits.
+inline void hex_encode(const uint8_t* in, size_t size, char* out) noexcept
+{
+    size_t i = 0;
+#if defined(EVMC_SIMD_AVX2)
+    for (; i + 32 <= size; i += 32)
+    {
+        const auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&in[i]));
+        const auto mask = _mm256_set1_epi8(0x0f);
+        const auto hi = hex_digits(_mm256_and_si256(_mm256_srli_epi16(x, 4), mask));
+        const auto lo = hex_digits(_mm256_and_si256(x, mask));
+        // The unpacking works within 128-bit lanes: bytes [0:8] and [16:24] in the first vector.
+        const auto a = _mm256_unpacklo_epi8(hi, lo);
+        const auto b = _mm256_unpackhi_epi8(hi, lo);
+        auto* const o = reinterpret_cast<__m256i*>(&out[2 * i]);
+        _mm256_storeu_si256(o, _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256(o + 1, _mm256_permute2x128_si256(a, b, 0x31));
+    }
+#endif
+#if defined(EVMC_SIMD_SSE2)
+    for (; i + 16 <= size; i += 16)
+    {
+        const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[i]));
+        const auto mask = _mm_set1_epi8(0x0f);
+        const auto hi = hex_digits(_mm_and_si128(_mm_srli_epi16(x, 4), mask));
+        const auto lo = hex_digits(_mm_and_si128(x, mask));
+        auto* const o = reinterpret_cast<__m128i*>(&out[2 * i]);
+        _mm_storeu_si128(o, _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(o + 1, _mm_unpackhi_epi8(hi, lo));
+    }
+#elif defined(EVMC_SIMD_NEON)
+    for (; i + 16 <= size; i += 16)
+    {
+        const auto x = vld1q_u8(&in[i]);
+        const auto hi = hex_digits(vshrq_n_u8(x, 4));
+        const auto lo = hex_digits(vandq_u8(x, vdupq_n_u8(0x0f)));
+        vst2q_u8(reinterpret_cast<uint8_t*>(&out[2 * i]), uint8x16x2_t{{hi, lo}});  // Interleaves.
+    }
+#endif
+    static constexpr auto digits = "0123456789abcdef";
+    for (auto* o = &out[2 * i]; i < size; ++i)
+    {
+        *o++ = digits[in[i] >> 4];
+        *o++ = digits[in[i] & 0xf];
+    }
+}
+
+/// Decodes the 2 * @p size hex digits to the @p size bytes.
+/// Returns false if an invalid hex digit is encountered, the output is then unspecified.
+inline bool hex_decode(const char* in, size_t size, uint8_t* out) noexcept
+{
+    size_t i = 0;
+#if defined(EVMC_SIMD_AVX2)
+    auto valid256 = _mm256_set1_epi8(-1);
+    for (; i + 32 <= size; i += 32)
+    {
+        const auto* const p = reinterpret_cast<const __m256i*>(&in[2 * i]);
+        const auto a = hex_combine(hex_nibbles(_mm256_loadu_si256(p), valid256));
+        const auto b = hex_combine(hex_nibbles(_mm256_loadu_si256(p + 1), valid256));
+        // The packing works within 128-bit lanes, the permutation restores the order.
+        const auto x = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xd8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out[i]), x);
+    }
+    if (_mm256_movemask_epi8(valid256) != -1)
+        return false;
+#endif
+#if defined(EVMC_SIMD_SSE2)
+    auto valid = _mm_set1_epi8(-1);
+    for (; i + 16 <= size; i += 16)
+    {
+        const auto* const p = reinterpret_cast<const __m128i*>(&in[2 * i]);
+        const auto a = hex_combine(hex_nibbles(_mm_loadu_si128(p), valid));
+        const auto b = hex_combine(hex_nibbles(_mm_loadu_si128(p + 1), valid));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&out[i]), _mm_packus_epi16(a, b));
+    }
+    if (_mm_movemask_epi8(valid) != 0xffff)
+        return false;
+#elif defined(EVMC_SIMD_NEON)
+    auto valid = vdupq_n_u8(0xff);
+    for (; i + 16 <= size; i += 16)
+    {
+        const auto c = vld2q_u8(reinterpret_cast<const uint8_t*>(&in[2 * i]));  // Deinterleaves.
+        const auto hi = hex_nibbles(c.val[0], valid);
+        const auto lo = hex_nibbles(c.val[1], valid);
+        vst1q_u8(&out[i], vorrq_u8(vshlq_n_u8(hi, 4), lo));
+    }
+    if (vminvq_u8(valid) != 0xff)
+        return false;
+#endif
+    for (; i < size; ++i)
+    {
+        const auto hi = from_hex_digit(in[2 * i]);
+        const auto lo = from_hex_digit(in[2 * i + 1]);
+        if ((hi | lo) < 0)
+            return false;
+        out[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return true;
+}
 }  // namespace internal
 
+/// Encodes bytes as hex into the caller-provided buffer of at least 2 * bs.size() characters.
+///
+/// @return  The pointer to the end of the written characters.
+inline char* hex(bytes_view bs, char* out) noexcept
+{
+    internal::hex_encode(bs.data(), bs.size(), out);
+    return out + 2 * bs.size();
+}
+
+/// Appends the hex encoding of the bytes to the string.
+inline void append_hex(std::string& str, bytes_view bs)
+{
+    const auto pos = str.size();
+    str.resize(pos + 2 * bs.size());
+    hex(bs, &str[pos]);
+}
+
+/// Encodes bytes as hex string.
+inline std::string hex(bytes_view bs)
+{
+    std::string str;
+    append_hex(str, bs);
+    return str;
+}
+
 /// Decodes hex-encoded sequence of characters.
 ///
 /// It is guaranteed that the output will not be longer than half of the input length.
@@ -94,6 +296,35 @@ inline bool validate_hex(std::string_view hex) noexcept
     return from_hex(hex.begin(), hex.end(), noop_output_iterator{});
 }
 
+/// Decodes hex encoded string, with the optional 0x prefix,
+/// into the caller-provided buffer of at least hex.size() / 2 bytes.
+///
+/// @return  The number of the written bytes or std::nullopt if the input is invalid:
+///          a non-hex digit or odd number of digits is encountered.
+inline std::optional<size_t> from_hex(std::string_view hex, uint8_t* out) noexcept
+{
+    if (hex.size() >= 2 && hex[0] == '0' && hex[1] == 'x')
+        hex.remove_prefix(2);
+    if (hex.size() % 2 != 0)
+        return {};
+    const auto size = hex.size() / 2;
+    if (!internal::hex_decode(hex.data(), size, out))
+        return {};
+    return size;
+}
+
+/// Decodes hex encoded string and appends the bytes to @p bs.
+///
+/// @return  False if the input is invalid, @p bs is then left unchanged.
+inline bool append_from_hex(bytes& bs, std::string_view hex)
+{
+    const auto pos = bs.size();
+    bs.resize(pos + hex.size() / 2);
+    const auto size = from_hex(hex, &bs[pos]);
+    bs.resize(size ? pos + *size : pos);
+    return size.has_value();
+}
+
 /// Decodes hex encoded string to bytes.
 ///
 /// In case the input is invalid the returned value is std::nullopt.
@@ -101,8 +332,7 @@ inline bool validate_hex(std::string_view hex) noexcept
 inline std::optional<bytes> from_hex(std::string_view hex)
 {
     bytes bs;
-    bs.reserve(hex.size() / 2);
-    if (!from_hex(hex.begin(), hex.end(), std::back_inserter(bs)))
+    if (!append_from_hex(bs, hex))
         return {};
     return bs;
 }
@@ -124,7 +354,12 @@ constexpr std::optional<T> from_hex(std::string_view s) noexcept
     const auto num_in_bytes = s.length() / 2;
     if (num_in_bytes > num_out_bytes)
         return {};
-    if (!from_hex(s.begin(), s.end(), &r.bytes[num_out_bytes - num_in_bytes]))
+    if (!detail::is_constant_evaluated())
+    {
+        if (!from_hex(s, &r.bytes[num_out_bytes - num_in_bytes]))
+            return {};
+    }
+    else if (!from_hex(s.begin(), s.end(), &r.bytes[num_out_bytes - num_in_bytes]))
         return {};
     return r;
 }
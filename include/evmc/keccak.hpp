@@ -0,0 +1,28 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+#pragma once
+
+#include <evmc/bytes.hpp>
+#include <evmc/evmc.hpp>
+#include <cstddef>
+
+namespace evmc
+{
+/// Computes the Keccak-256 hash of the data.
+///
+/// This is the original Keccak padding used by Ethereum, not the standardized SHA3-256.
+/// Provided by the evmc::keccak library.
+bytes32 keccak256(bytes_view data) noexcept;
+
+/// Computes the Keccak-256 hashes of @p n independent inputs.
+///
+/// The inputs are hashed in parallel in the lanes of the vector registers: in groups of 8
+/// if the CPU supports AVX-512, in groups of 4 if it supports AVX2. A group costs as much as
+/// its longest input, so it pays off to pass inputs of similar sizes.
+///
+/// @param inputs   The array of @p n inputs.
+/// @param outputs  The array of @p n hashes, the output of the input of the same index.
+/// @param n        The number of inputs.
+void keccak256(const bytes_view inputs[], bytes32 outputs[], size_t n) noexcept;
+}  // namespace evmc
@@ -4,10 +4,14 @@
 #pragma once
 
 #include <evmc/evmc.hpp>
+#include <evmc/flat_map.hpp>
+#include <evmc/keccak.hpp>
+#include <evmc/uint256.hpp>
 #include <algorithm>
 #include <cassert>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace evmc
@@ -41,8 +45,30 @@ struct StorageValue
     {}
 };
 
-/// Mocked account.
-struct MockedAccount
+/// The MockedHost state containers policy using evmc::flat_map.
+///
+/// The accounts and storage lookups take usually a single probe of a cache-friendly table
+/// but the references to the accounts and storage values are invalidated by insertions.
+struct FlatMapPolicy
+{
+    /// The map type.
+    template <typename Key, typename T>
+    using map = flat_map<Key, T, fast_hash>;
+};
+
+/// The MockedHost state containers policy using the node-based std::unordered_map (the default).
+///
+/// The references to the accounts and storage values remain valid after insertions.
+struct StdMapPolicy
+{
+    /// The map type.
+    template <typename Key, typename T>
+    using map = std::unordered_map<Key, T>;
+};
+
+/// Mocked account with the storage containers selected by the MapPolicy.
+template <typename MapPolicy>
+struct BasicMockedAccount
 {
     /// The account nonce.
     int nonce = 0;
@@ -51,30 +77,47 @@ struct MockedAccount
     bytes code;
 
     /// The code hash. Can be a value not related to the actual code.
+    /// If zero, the Keccak-256 hash of the non-empty code is reported by the MockedHost.
     bytes32 codehash;
 
     /// The account balance.
     uint256be balance;
 
     /// The account storage map.
-    std::unordered_map<bytes32, StorageValue> storage;
+    typename MapPolicy::template map<bytes32, StorageValue> storage;
 
     /// The account transient storage.
-    std::unordered_map<bytes32, bytes32> transient_storage;
+    typename MapPolicy::template map<bytes32, bytes32> transient_storage;
 
     /// Helper method for setting balance by numeric type.
-    void set_balance(uint64_t x) noexcept
+    void set_balance(const uint256& x) noexcept { balance = static_cast<uint256be>(x); }
+
+    /// Helper method for setting the code together with its Keccak-256 hash.
+    void set_code(bytes c)
     {
-        balance = uint256be{};
-        for (std::size_t i = 0; i < sizeof(x); ++i)
-            balance.bytes[sizeof(balance) - 1 - i] = static_cast<uint8_t>(x >> (8 * i));
+        code = std::move(c);
+        codehash = keccak256(code);
     }
 };
 
-/// Mocked EVMC Host implementation.
-class MockedHost : public Host
+/// Mocked account.
+struct MockedAccount : BasicMockedAccount<StdMapPolicy>
+{};
+
+/// Mocked EVMC Host implementation with the state containers selected by the MapPolicy.
+///
+/// The AccountType is the type of the accounts, BasicMockedAccount<MapPolicy> by default.
+template <typename MapPolicy = StdMapPolicy,
+          typename AccountType = BasicMockedAccount<MapPolicy>>
+class BasicMockedHost : public Host
 {
 public:
+    /// The account type.
+    using Account = AccountType;
+
+    /// The type of the accounts map.
+    using AccountMap = typename MapPolicy::template map<address, Account>;
+
     /// LOG record.
     struct log_record
     {
@@ -95,7 +138,7 @@ public:
     };
 
     /// The set of all accounts in the Host, organized by their addresses.
-    std::unordered_map<address, MockedAccount> accounts;
+    AccountMap accounts;
 
     /// The EVMC transaction context to be returned by get_tx_context().
     evmc_tx_context tx_context = {};
@@ -134,6 +177,95 @@ private:
     /// The copy of call inputs for the recorded_calls record.
     std::vector<bytes> m_recorded_calls_inputs;
 
+    /// The entry of the state change journal.
+    struct JournalEntry
+    {
+        /// The kind of the state change.
+        enum Kind
+        {
+            account_created,             ///< The account has been created.
+            storage_created,             ///< The storage entry has been created.
+            storage_modified,            ///< The storage entry has been modified.
+            transient_storage_created,   ///< The transient storage entry has been created.
+            transient_storage_modified,  ///< The transient storage entry has been modified.
+            selfdestruct_recorded,       ///< The selfdestruct beneficiary has been recorded.
+        };
+
+        Kind kind;                  ///< The kind of the state change.
+        address addr;               ///< The address of the modified account.
+        bytes32 key;                ///< The storage key (if applicable).
+        StorageValue prev_storage;  ///< The previous (transient) storage value (if applicable).
+    };
+
+    /// The checkpoint of the host state.
+    struct Checkpoint
+    {
+        size_t journal_size = 0;            ///< The size of the journal.
+        size_t num_blockhashes = 0;         ///< The size of recorded_blockhashes.
+        size_t num_account_accesses = 0;    ///< The size of recorded_account_accesses.
+        size_t num_calls = 0;               ///< The size of recorded_calls.
+        size_t num_calls_inputs = 0;        ///< The number of recorded call inputs.
+        size_t num_logs = 0;                ///< The size of recorded_logs.
+        size_t num_dirty_storage = 0;       ///< The size of the dirty storage list.
+        size_t num_transient_accounts = 0;  ///< The size of the transient storage account list.
+    };
+
+    /// The journal of the state changes done after the first checkpoint.
+    std::vector<JournalEntry> m_journal;
+
+    /// The list of active checkpoints.
+    std::vector<Checkpoint> m_checkpoints;
+
+    /// The storage entries modified or accessed in the current transaction.
+    /// May contain duplicates, e.g. if a slot is restored to the original value and modified again.
+    std::vector<std::pair<address, bytes32>> m_dirty_storage;
+
+    /// The accounts to which the transient storage has been written in the current transaction.
+    std::vector<address> m_transient_accounts;
+
+    /// Returns true if the storage entry is unchanged since the transaction start.
+    static bool is_clean(const StorageValue& s) noexcept
+    {
+        return s.current == s.original && s.access_status == EVMC_ACCESS_COLD;
+    }
+
+    /// Adds the storage entry to the dirty list if it has been clean before the update.
+    void track_storage_update(const address& addr,
+                              const bytes32& key,
+                              bool was_clean,
+                              const StorageValue& s)
+    {
+        if (was_clean && !is_clean(s))
+            m_dirty_storage.emplace_back(addr, key);
+    }
+
+    /// Returns true if the state changes are journaled.
+    bool is_journaling() const noexcept { return !m_checkpoints.empty(); }
+
+    /// Gets the account of the given address. Creates it and journals the creation if needed.
+    Account& get_or_create_account(const address& addr)
+    {
+        const auto [it, created] = accounts.try_emplace(addr);
+        if (created && is_journaling())
+            m_journal.push_back({JournalEntry::account_created, addr, {}, {}});
+        return it->second;
+    }
+
+    /// Gets the storage entry of the given account and key.
+    /// Creates it if needed and journals the change to be made.
+    StorageValue& get_storage_for_update(const address& addr, const bytes32& key)
+    {
+        auto& storage = get_or_create_account(addr).storage;
+        const auto [it, created] = storage.try_emplace(key);
+        if (is_journaling())
+        {
+            m_journal.push_back(
+                {created ? JournalEntry::storage_created : JournalEntry::storage_modified, addr,
+                 key, it->second});
+        }
+        return it->second;
+    }
+
     /// Record an account access.
     /// @param addr  The address of the accessed account.
     void record_account_access(const address& addr) const
@@ -179,7 +311,8 @@ public:
         // This will create the account in case it was not present.
         // This is convenient for unit testing and standalone EVM execution to preserve the
         // storage values after the execution terminates.
-        auto& s = accounts[addr].storage[key];
+        auto& s = get_storage_for_update(addr, key);
+        const auto was_clean = is_clean(s);
 
         // Follow the EIP-2200 specification as closely as possible.
         // https://eips.ethereum.org/EIPS/eip-2200
@@ -310,6 +443,7 @@ public:
         }();
 
         s.current = value;  // Finally update the current storage value.
+        track_storage_update(addr, key, was_clean, s);
         return status;
     }
 
@@ -341,7 +475,10 @@ public:
         const auto it = accounts.find(addr);
         if (it == accounts.end())
             return {};
-        return it->second.codehash;
+        const auto& acc = it->second;
+        if (is_zero(acc.codehash) && !acc.code.empty())
+            return keccak256(acc.code);
+        return acc.codehash;
     }
 
     /// Copy the account's code to the given buffer (EVMC host method).
@@ -373,6 +510,8 @@ public:
         record_account_access(addr);
         auto& beneficiaries = recorded_selfdestructs[addr];
         beneficiaries.emplace_back(beneficiary);
+        if (is_journaling())
+            m_journal.push_back({JournalEntry::selfdestruct_recorded, addr, {}, {}});
         return beneficiaries.size() == 1;
     }
 
@@ -470,9 +609,11 @@ public:
     ///              the ::EVMC_ACCESS_COLD otherwise.
     evmc_access_status access_storage(const address& addr, const bytes32& key) noexcept override
     {
-        auto& value = accounts[addr].storage[key];
+        auto& value = get_storage_for_update(addr, key);
         const auto access_status = value.access_status;
+        const auto was_clean = is_clean(value);
         value.access_status = EVMC_ACCESS_WARM;
+        track_storage_update(addr, key, was_clean, value);
         return access_status;
     }
 
@@ -505,7 +646,134 @@ public:
                                const bytes32& value) noexcept override
     {
         record_account_access(addr);
-        accounts[addr].transient_storage[key] = value;
+        auto& transient_storage = get_or_create_account(addr).transient_storage;
+        const auto [it, created] = transient_storage.try_emplace(key);
+        if (created && transient_storage.size() == 1)
+            m_transient_accounts.emplace_back(addr);
+        if (is_journaling())
+        {
+            m_journal.push_back({created ? JournalEntry::transient_storage_created :
+                                           JournalEntry::transient_storage_modified,
+                                 addr, key, it->second});
+        }
+        it->second = value;
+    }
+
+    /// Creates a checkpoint of the host state.
+    ///
+    /// Starting from the first checkpoint, the state changes done by the Host methods are recorded
+    /// in the journal. The cost of a revert is therefore proportional to the number of changes
+    /// made after the checkpoint, not to the size of the state. The modifications done directly
+    /// to the MockedHost::accounts are not journaled.
+    ///
+    /// @return  The checkpoint identifier to be used in revert().
+    size_t checkpoint()
+    {
+        m_checkpoints.push_back({m_journal.size(), recorded_blockhashes.size(),
+                                 recorded_account_accesses.size(), recorded_calls.size(),
+                                 m_recorded_calls_inputs.size(), recorded_logs.size(),
+                                 m_dirty_storage.size(), m_transient_accounts.size()});
+        return m_checkpoints.size() - 1;
+    }
+
+    /// Reverts the host state to the given checkpoint.
+    ///
+    /// The accounts, storage and transient storage entries modified after the checkpoint are
+    /// restored and the records (e.g. recorded_calls, recorded_logs) are truncated.
+    /// The checkpoint remains valid and can be reverted to again,
+    /// the checkpoints created after it are discarded.
+    ///
+    /// @param checkpoint_id  The identifier of the checkpoint returned by checkpoint().
+    void revert(size_t checkpoint_id)
+    {
+        assert(checkpoint_id < m_checkpoints.size());
+        const auto cp = m_checkpoints[checkpoint_id];
+        m_checkpoints.resize(checkpoint_id + 1);
+
+        while (m_journal.size() > cp.journal_size)
+        {
+            const auto& e = m_journal.back();
+            switch (e.kind)
+            {
+            case JournalEntry::account_created:
+                accounts.erase(e.addr);
+                break;
+            case JournalEntry::storage_created:
+                accounts[e.addr].storage.erase(e.key);
+                break;
+            case JournalEntry::storage_modified:
+                accounts[e.addr].storage[e.key] = e.prev_storage;
+                break;
+            case JournalEntry::transient_storage_created:
+                accounts[e.addr].transient_storage.erase(e.key);
+                break;
+            case JournalEntry::transient_storage_modified:
+                accounts[e.addr].transient_storage[e.key] = e.prev_storage.current;
+                break;
+            case JournalEntry::selfdestruct_recorded:
+            {
+                const auto it = recorded_selfdestructs.find(e.addr);
+                it->second.pop_back();
+                if (it->second.empty())
+                    recorded_selfdestructs.erase(it);
+                break;
+            }
+            }
+            m_journal.pop_back();
+        }
+
+        recorded_blockhashes.resize(cp.num_blockhashes);
+        recorded_account_accesses.resize(cp.num_account_accesses);
+        recorded_calls.resize(cp.num_calls);
+        m_recorded_calls_inputs.resize(cp.num_calls_inputs);
+        recorded_logs.resize(cp.num_logs);
+        m_dirty_storage.resize(cp.num_dirty_storage);
+        m_transient_accounts.resize(cp.num_transient_accounts);
+    }
+
+    /// Commits the current transaction.
+    ///
+    /// The current storage values become the original values, the storage keys and
+    /// the accounts become cold (MockedHost::recorded_account_accesses is cleared) and
+    /// the transient storage is cleared. Only the storage entries modified or accessed
+    /// by the Host methods in the transaction are visited so the cost is proportional
+    /// to the number of them, not to the size of the state. The modifications done directly
+    /// to the MockedHost::accounts are not tracked.
+    ///
+    /// The committed changes cannot be reverted: the journal and all checkpoints are discarded.
+    void commit_transaction()
+    {
+        for (const auto& [addr, key] : m_dirty_storage)
+        {
+            // The entries may be gone if the accounts have been modified directly.
+            const auto acc = accounts.find(addr);
+            if (acc == accounts.end())
+                continue;
+            const auto it = acc->second.storage.find(key);
+            if (it == acc->second.storage.end())
+                continue;
+            it->second.original = it->second.current;
+            it->second.access_status = EVMC_ACCESS_COLD;
+        }
+        m_dirty_storage.clear();
+
+        for (const auto& addr : m_transient_accounts)
+        {
+            if (const auto acc = accounts.find(addr); acc != accounts.end())
+                acc->second.transient_storage.clear();
+        }
+        m_transient_accounts.clear();
+
+        recorded_account_accesses.clear();
+        m_journal.clear();
+        m_checkpoints.clear();
     }
 };
+
+/// Mocked EVMC Host implementation.
+class MockedHost : public BasicMockedHost<StdMapPolicy, MockedAccount>
+{};
+
+/// Mocked EVMC Host implementation with the state in the flat hash maps (see FlatMapPolicy).
+using FlatMockedHost = BasicMockedHost<FlatMapPolicy>;
 }  // namespace evmc
@@ -0,0 +1,70 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+/// @file
+/// Detection of the compiler and target features used by the runtime implementations
+/// in the C++ headers.
+#pragma once
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define EVMC_HAS_BUILTIN_IS_CONSTANT_EVALUATED 1
+#endif
+#endif
+#if !defined(EVMC_HAS_BUILTIN_IS_CONSTANT_EVALUATED) && \
+    ((defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925))
+#define EVMC_HAS_BUILTIN_IS_CONSTANT_EVALUATED 1
+#endif
+
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_MSC_VER)
+#define EVMC_LITTLE_ENDIAN 1
+#endif
+
+// The SIMD implementations can be disabled by defining EVMC_NO_SIMD.
+#if !defined(EVMC_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EVMC_SIMD_SSE2 1
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#define EVMC_SIMD_AVX2 1
+#include <immintrin.h>
+#endif
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#define EVMC_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <stdlib.h>
+#endif
+
+namespace evmc::detail
+{
+/// Checks if the function call occurs within a constant-evaluated context.
+///
+/// Without the compiler support it always returns true so that
+/// the constexpr implementations are used also at runtime.
+/// TODO(c++20): Use std::is_constant_evaluated().
+inline constexpr bool is_constant_evaluated() noexcept
+{
+#if defined(EVMC_HAS_BUILTIN_IS_CONSTANT_EVALUATED)
+    return __builtin_is_constant_evaluated();
+#else
+    return true;
+#endif
+}
+
+/// Checks if the runtime implementations (unaligned loads, byte swaps and SIMD)
+/// can be used instead of the constexpr ones.
+inline constexpr bool use_runtime_impl() noexcept
+{
+#if defined(EVMC_LITTLE_ENDIAN)
+    return !is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+}  // namespace evmc::detail
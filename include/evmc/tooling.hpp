@@ -1,13 +1,856 @@
 // EVMC: Ethereum Client-VM Connector API.
 // Copyright 2020 The EVMC Authors.
 // Licensed under the Apache License, Version 2.0.
+#pragma once
 
 #include <evmc/evmc.hpp>
+#include <evmc/mocked_host.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
 #include <iosfwd>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace evmc::tooling
 {
+/// The format of the machine-readable benchmark report.
+enum class ReportFormat
+{
+    json,
+    csv,
+};
+
+/// The benchmark configuration.
+struct BenchOptions
+{
+    /// The number of executions before the measurements start.
+    int warmup_iterations = 10;
+
+    /// The number of samples to collect. Each sample is the average time of a batch of executions.
+    int num_samples = 30;
+
+    /// The target duration of a single sample.
+    /// The number of executions in a batch is calibrated to match it.
+    std::chrono::nanoseconds sample_time = std::chrono::milliseconds{30};
+
+    /// Restore the host state after every execution so that all executions start
+    /// from the same state. The measured time includes the (small) cost of the restoration.
+    bool isolate_state = false;
+
+    /// The output stream for the machine-readable report. No report is written if null.
+    std::ostream* report = nullptr;
+
+    /// The format of the machine-readable report.
+    ReportFormat report_format = ReportFormat::json;
+
+    /// Collect the hardware performance counters during the measurements (Linux only).
+    /// The counters not available on the system are skipped.
+    bool perf_counters = false;
+
+    /// Profile the host callbacks in additional executions after the measurements
+    /// (see HostProfiler).
+    bool profile_host = false;
+
+    /// Count the heap allocations of the VM and of the host in additional executions after
+    /// the measurements. Requires the allocation hooks (see alloc_tracking_available()).
+    bool track_allocations = false;
+
+    /// The number of threads executing the code concurrently in the scaling benchmark.
+    /// The scaling benchmark is performed only if greater than 1.
+    /// The threads share the VM instance, so the VM must be thread-safe.
+    int num_threads = 1;
+
+    /// The CPUs to pin the scaling benchmark threads to: the thread i is pinned to
+    /// the CPU cpus[i % cpus.size()]. The threads are not pinned if empty.
+    /// Pinning is only supported on Linux.
+    std::vector<int> cpus;
+};
+
+/// The statistics of the benchmark samples. All times are in nanoseconds per execution.
+struct BenchStats
+{
+    size_t num_samples = 0;  ///< The number of samples.
+    double min = 0;          ///< The minimum.
+    double max = 0;          ///< The maximum.
+    double mean = 0;         ///< The arithmetic mean.
+    double median = 0;       ///< The median (50th percentile).
+    double p90 = 0;          ///< The 90th percentile.
+    double p99 = 0;          ///< The 99th percentile.
+    double stddev = 0;       ///< The sample standard deviation.
+    double ci95_low = 0;     ///< The lower bound of the 95% confidence interval of the mean.
+    double ci95_high = 0;    ///< The upper bound of the 95% confidence interval of the mean.
+
+    /// The number of samples outside of the Tukey's fences [Q1 - 1.5 IQR, Q3 + 1.5 IQR].
+    size_t num_outliers = 0;
+};
+
+/// The hardware performance events.
+enum class PerfEvent
+{
+    cycles,
+    instructions,
+    branch_misses,
+    l1d_misses,
+    llc_misses,
+    dtlb_misses,
+};
+
+/// The number of the PerfEvent values.
+constexpr size_t num_perf_events = static_cast<size_t>(PerfEvent::dtlb_misses) + 1;
+
+/// Returns the name of the hardware performance event.
+const char* to_string(PerfEvent event) noexcept;
+
+/// The hardware performance counter values per execution.
+struct PerfCounters
+{
+    /// The values indexed by PerfEvent. Empty if the counter is not available.
+    std::array<std::optional<double>, num_perf_events> values;
+
+    /// Returns the value of the counter.
+    std::optional<double> operator[](PerfEvent event) const noexcept
+    {
+        return values[static_cast<size_t>(event)];
+    }
+
+    /// Returns the number of instructions per cycle if both counters are available.
+    std::optional<double> ipc() const noexcept
+    {
+        const auto cycles = (*this)[PerfEvent::cycles];
+        const auto instructions = (*this)[PerfEvent::instructions];
+        if (!cycles || !instructions || *cycles == 0)
+            return {};
+        return *instructions / *cycles;
+    }
+};
+
+/// The heap allocation counters per execution.
+struct AllocCounters
+{
+    double num_allocations = 0;  ///< The number of allocations.
+    double bytes_allocated = 0;  ///< The number of bytes allocated (usable sizes of blocks).
+};
+
+/// The heap allocation statistics of the benchmark.
+struct AllocStats
+{
+    AllocCounters vm;    ///< The allocations of the VM (outside of the host callbacks).
+    AllocCounters host;  ///< The allocations in the host callbacks.
+
+    /// The maximum number of bytes allocated and not yet freed during a single execution.
+    uint64_t peak_live_bytes = 0;
+};
+
+/// Returns true if the allocation hooks are linked into the program.
+///
+/// The hooks interposing the allocation functions are provided by the evmc::alloc-hooks
+/// object library which must be linked into the executable. They are only available with glibc
+/// and are disabled in the sanitizer builds. The C++ operator new and delete are not replaced,
+/// so their allocations are only counted if the C++ runtime implements them with malloc()
+/// and free(), as libstdc++ and libc++ do by default.
+bool alloc_tracking_available() noexcept;
+
+/// The identifiers of the Host methods.
+enum class HostMethod : uint8_t
+{
+    account_exists,
+    get_storage,
+    set_storage,
+    get_balance,
+    get_code_size,
+    get_code_hash,
+    copy_code,
+    selfdestruct,
+    call,
+    get_tx_context,
+    get_block_hash,
+    emit_log,
+    access_account,
+    access_storage,
+    get_transient_storage,
+    set_transient_storage,
+    allocate_output,
+};
+
+/// The number of the HostMethod values.
+constexpr size_t num_host_methods = static_cast<size_t>(HostMethod::allocate_output) + 1;
+
+/// Returns the name of the Host method.
+const char* to_string(HostMethod method) noexcept;
+
+/// The Host decorator invoking the hooks around every callback to the wrapped host.
+///
+/// The Hooks type must provide the enter(HostMethod) and leave(HostMethod) methods
+/// which are invoked before and after every callback respectively.
+template <typename Hooks>
+class HookedHost : public Host
+{
+    HostInterface& m_host;
+    Hooks& m_hooks;
+
+    /// Invokes the hooks around the callback.
+    class Scope
+    {
+        Hooks& m_hooks;
+        HostMethod m_method;
+
+    public:
+        Scope(Hooks& hooks, HostMethod method) noexcept : m_hooks{hooks}, m_method{method}
+        {
+            m_hooks.enter(m_method);
+        }
+        ~Scope() noexcept { m_hooks.leave(m_method); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+public:
+    HookedHost(HostInterface& host, Hooks& hooks) noexcept : m_host{host}, m_hooks{hooks} {}
+
+    bool account_exists(const address& addr) const noexcept override
+    {
+        const Scope scope{m_hooks, HostMethod::account_exists};
+        return m_host.account_exists(addr);
+    }
+
+    bytes32 get_storage(const address& addr, const bytes32& key) const noexcept override
+    {
+        const Scope scope{m_hooks, HostMethod::get_storage};
+        return m_host.get_storage(addr, key);
+    }
+
+    evmc_storage_status set_storage(const address& addr,
+                                    const bytes32& key,
+                                    const bytes32& value) noexcept override
+    {
+        const Scope scope{m_hooks, HostMethod::set_storage};
+        return m_host.set_storage(addr, key, value);
+    }
+
+    uint256be get_balance(const address& addr) const noexcept override
+    {
+        const Scope scope{m_hooks, HostMethod::get_balance};
+        return m_host.get_balance(addr);
+    }
+
+    size_t get_code_size(const address& addr) const noexcept override
+    {
+        const Scope scope{m_hooks, HostMethod::get_code_size};
+        return m_host.get_code_size(addr);
+    }
+
+    bytes32 get_code_hash(const address& addr) const noexcept override
+    {
+        const Scope scope{m_hooks, HostMethod::get_code_hash};
+        return m_host.get_code_hash(addr);
+    }
+
+    size_t copy_code(const address& addr,
+                     size_t code_offset,
+                     uint8_t* buffer_data,
+                     size_t buffer_size) const noexcept override
+    {
+        const Scope scope{m_hooks, HostMethod::copy_code};
+        return m_host.copy_code(addr, code_offset, buffer_data, buffer_size);
+    }
+
+    bool selfdestruct(const address& addr, const address& beneficiary) noexcept override
+    {
+        const Scope scope{m_hooks, HostMethod::selfdestruct};
+        return m_host.selfdestruct(addr, beneficiary);
+    }
+
+    Result call(const evmc_message& msg) noexcept override
+    {
+        const Scope scope{m_hooks, HostMethod::call};
+        return m_host.call(msg);
+    }
+
+    evmc_tx_context get_tx_context() const noexcept override
+    {
+        const Scope scope{m_hooks, HostMethod::get_tx_context};
+        return m_host.get_tx_context();
+    }
+
+    bytes32 get_block_hash(int64_t block_number) const noexcept override
+    {
+        const Scope scope{m_hooks, HostMethod::get_block_hash};
+        return m_host.get_block_hash(block_number);
+    }
+
+    void emit_log(const address& addr,
+                  const uint8_t* data,
+                  size_t data_size,
+                  const bytes32 topics[],
+                  size_t num_topics) noexcept override
+    {
+        const Scope scope{m_hooks, HostMethod::emit_log};
+        m_host.emit_log(addr, data, data_size, topics, num_topics);
+    }
+
+    evmc_access_status access_account(const address& addr) noexcept override
+    {
+        const Scope scope{m_hooks, HostMethod::access_account};
+        return m_host.access_account(addr);
+    }
+
+    evmc_access_status access_storage(const address& addr, const bytes32& key) noexcept override
+    {
+        const Scope scope{m_hooks, HostMethod::access_storage};
+        return m_host.access_storage(addr, key);
+    }
+
+    bytes32 get_transient_storage(const address& addr, const bytes32& key) const noexcept override
+    {
+        const Scope scope{m_hooks, HostMethod::get_transient_storage};
+        return m_host.get_transient_storage(addr, key);
+    }
+
+    void set_transient_storage(const address& addr,
+                               const bytes32& key,
+                               const bytes32& value) noexcept override
+    {
+        const Scope scope{m_hooks, HostMethod::set_transient_storage};
+        m_host.set_transient_storage(addr, key, value);
+    }
+
+    uint8_t* allocate_output(size_t size) noexcept override
+    {
+        const Scope scope{m_hooks, HostMethod::allocate_output};
+        return m_host.allocate_output(size);
+    }
+};
+
+/// The statistics of the calls to a Host method.
+struct HostMethodStats
+{
+    uint64_t num_calls = 0;        ///< The number of calls.
+    uint64_t num_timed_calls = 0;  ///< The number of calls with the latency measured.
+    double timed_ns = 0;           ///< The total latency of the timed calls in nanoseconds.
+
+    /// The mean latency of a call in nanoseconds.
+    double mean_latency() const noexcept
+    {
+        return num_timed_calls != 0 ? timed_ns / static_cast<double>(num_timed_calls) : 0;
+    }
+
+    /// The estimated total time spent in the calls in nanoseconds.
+    double estimated_time() const noexcept
+    {
+        return mean_latency() * static_cast<double>(num_calls);
+    }
+};
+
+/// The HookedHost hooks counting the calls of every Host method and sampling their latency.
+///
+/// The latency of the first call and of every sample_period-th call of a method is measured
+/// to limit the overhead of the clock. The nested callbacks are not timed separately.
+class HostProfiler
+{
+    std::array<HostMethodStats, num_host_methods> m_stats{};
+    uint32_t m_sample_period;
+    uint32_t m_depth = 0;
+    bool m_timing = false;
+    std::chrono::steady_clock::time_point m_start;
+
+public:
+    /// Creates the profiler measuring the latency of every sample_period-th call of a method.
+    explicit HostProfiler(uint32_t sample_period = 16) noexcept
+      : m_sample_period{sample_period != 0 ? sample_period : 1}
+    {}
+
+    /// Returns the statistics of the method calls, indexed by HostMethod.
+    const std::array<HostMethodStats, num_host_methods>& stats() const noexcept
+    {
+        return m_stats;
+    }
+
+    void enter(HostMethod method) noexcept;
+    void leave(HostMethod method) noexcept;
+};
+
+/// The Host decorator profiling the callbacks to the wrapped host.
+using InstrumentedHost = HookedHost<HostProfiler>;
+
+/// The profile of the host callbacks of the benchmarked executions.
+struct HostProfile
+{
+    /// The statistics of the method calls of all executions, indexed by HostMethod.
+    std::array<HostMethodStats, num_host_methods> methods{};
+
+    uint64_t num_executions = 0;  ///< The number of profiled executions.
+    double total_time = 0;        ///< The wall time of all executions in nanoseconds.
+
+    /// The number of host callbacks per execution.
+    double calls_per_execution() const noexcept
+    {
+        uint64_t sum = 0;
+        for (const auto& m : methods)
+            sum += m.num_calls;
+        return num_executions != 0 ?
+                   static_cast<double>(sum) / static_cast<double>(num_executions) :
+                   0;
+    }
+
+    /// The estimated time spent in the host callbacks of all executions in nanoseconds.
+    double host_time() const noexcept
+    {
+        double sum = 0;
+        for (const auto& m : methods)
+            sum += m.estimated_time();
+        return sum;
+    }
+
+    /// The fraction of the wall time spent in the host callbacks.
+    double host_fraction() const noexcept
+    {
+        return total_time > 0 ? std::min(host_time() / total_time, 1.0) : 0;
+    }
+};
+
+/// The result of a benchmark.
+struct BenchResult
+{
+    std::string vm_name;          ///< The name of the benchmarked VM.
+    std::string vm_version;       ///< The version of the benchmarked VM.
+    evmc_revision rev = {};       ///< The EVM revision.
+    int64_t gas_used = 0;         ///< The amount of gas used by a single execution.
+    uint64_t batch_size = 0;      ///< The number of executions in a single sample.
+    std::vector<double> samples;  ///< The samples: average execution times in nanoseconds.
+    BenchStats stats;             ///< The statistics of the samples.
+
+    /// The hardware performance counters if requested by BenchOptions::perf_counters.
+    std::optional<PerfCounters> perf;
+
+    /// The heap allocation statistics if requested by BenchOptions::track_allocations
+    /// and available.
+    std::optional<AllocStats> allocs;
+
+    /// The profile of the host callbacks if requested by BenchOptions::profile_host.
+    std::optional<HostProfile> host_profile;
+
+    /// The execution throughput in millions of gas units per second (based on the median time).
+    double gas_rate() const noexcept
+    {
+        return stats.median > 0 ? static_cast<double>(gas_used) * 1e3 / stats.median : 0;
+    }
+};
+
+/// The Host decorator recording all the callbacks to the wrapped host.
+///
+/// Every callback is forwarded to the wrapped host and logged with its arguments and results.
+/// The recording starts with an 8-byte header (the magic "EVMCREC" and the format version)
+/// followed by the records: the HostMethod byte, the length-prefixed arguments and
+/// the length-prefixed results. The integers are encoded in little-endian order.
+/// The nested calls are not executed on replay, so only the results of Host::call() are logged.
+class RecordingHost : public Host
+{
+    HostInterface& m_host;
+    mutable bytes m_recording;
+
+public:
+    /// Creates the recording host forwarding the callbacks to the given host.
+    /// The C host interface can be wrapped with HostContext.
+    explicit RecordingHost(HostInterface& host);
+
+    /// Returns the recording of the callbacks made so far.
+    const bytes& recording() const noexcept { return m_recording; }
+
+    bool account_exists(const address& addr) const noexcept override;
+    bytes32 get_storage(const address& addr, const bytes32& key) const noexcept override;
+    evmc_storage_status set_storage(const address& addr,
+                                    const bytes32& key,
+                                    const bytes32& value) noexcept override;
+    uint256be get_balance(const address& addr) const noexcept override;
+    size_t get_code_size(const address& addr) const noexcept override;
+    bytes32 get_code_hash(const address& addr) const noexcept override;
+    size_t copy_code(const address& addr,
+                     size_t code_offset,
+                     uint8_t* buffer_data,
+                     size_t buffer_size) const noexcept override;
+    bool selfdestruct(const address& addr, const address& beneficiary) noexcept override;
+    Result call(const evmc_message& msg) noexcept override;
+    evmc_tx_context get_tx_context() const noexcept override;
+    bytes32 get_block_hash(int64_t block_number) const noexcept override;
+    void emit_log(const address& addr,
+                  const uint8_t* data,
+                  size_t data_size,
+                  const bytes32 topics[],
+                  size_t num_topics) noexcept override;
+    evmc_access_status access_account(const address& addr) noexcept override;
+    evmc_access_status access_storage(const address& addr, const bytes32& key) noexcept override;
+    bytes32 get_transient_storage(const address& addr, const bytes32& key) const noexcept override;
+    void set_transient_storage(const address& addr,
+                               const bytes32& key,
+                               const bytes32& value) noexcept override;
+
+    /// Forwards the allocation to the wrapped host. The allocations are not recorded
+    /// because they do not depend on the host state.
+    uint8_t* allocate_output(size_t size) noexcept override;
+};
+
+/// The Host serving the answers from a recording made by RecordingHost.
+///
+/// The records are consumed sequentially without any state lookups. The arguments of every
+/// callback are checked against the recorded ones. On the first mismatch the replay is marked
+/// as diverged and all the following callbacks return zero values.
+class ReplayHost : public Host
+{
+    bytes m_recording;
+    HostInterface* m_host = nullptr;
+    mutable size_t m_position = 0;
+    mutable bool m_diverged = false;
+
+    /// The buffer for encoding the arguments of the current callback.
+    mutable bytes m_args;
+
+    /// The storage for the initcodes returned by get_tx_context().
+    mutable std::vector<evmc_tx_initcode> m_initcodes;
+
+public:
+    /// Creates the replay host from the recording.
+    ///
+    /// The optional host only provides the memory for the outputs with allocate_output(),
+    /// the other callbacks are served from the recording.
+    ///
+    /// @throws std::invalid_argument  If the recording is malformed.
+    explicit ReplayHost(bytes recording, HostInterface* host = nullptr);
+
+    /// Returns the position of the next record to replay.
+    size_t position() const noexcept { return m_position; }
+
+    /// Restarts the replay from the given position (by default from the first record).
+    /// The position must be the one previously returned by position().
+    void rewind(std::optional<size_t> position = {}) noexcept;
+
+    /// Returns true if the callbacks did not match the recording.
+    bool diverged() const noexcept { return m_diverged; }
+
+    /// Returns true if all the records have been replayed.
+    bool finished() const noexcept { return m_position == m_recording.size(); }
+
+    bool account_exists(const address& addr) const noexcept override;
+    bytes32 get_storage(const address& addr, const bytes32& key) const noexcept override;
+    evmc_storage_status set_storage(const address& addr,
+                                    const bytes32& key,
+                                    const bytes32& value) noexcept override;
+    uint256be get_balance(const address& addr) const noexcept override;
+    size_t get_code_size(const address& addr) const noexcept override;
+    bytes32 get_code_hash(const address& addr) const noexcept override;
+    size_t copy_code(const address& addr,
+                     size_t code_offset,
+                     uint8_t* buffer_data,
+                     size_t buffer_size) const noexcept override;
+    bool selfdestruct(const address& addr, const address& beneficiary) noexcept override;
+    Result call(const evmc_message& msg) noexcept override;
+    evmc_tx_context get_tx_context() const noexcept override;
+    bytes32 get_block_hash(int64_t block_number) const noexcept override;
+    void emit_log(const address& addr,
+                  const uint8_t* data,
+                  size_t data_size,
+                  const bytes32 topics[],
+                  size_t num_topics) noexcept override;
+    evmc_access_status access_account(const address& addr) noexcept override;
+    evmc_access_status access_storage(const address& addr, const bytes32& key) noexcept override;
+    bytes32 get_transient_storage(const address& addr, const bytes32& key) const noexcept override;
+    void set_transient_storage(const address& addr,
+                               const bytes32& key,
+                               const bytes32& value) noexcept override;
+
+    /// Forwards the allocation to the host given to the constructor, if any.
+    uint8_t* allocate_output(size_t size) noexcept override;
+
+private:
+    /// Checks the next record against the method and the encoded arguments in #m_args.
+    /// Returns the recorded results or empty bytes if the replay diverged.
+    bytes_view next(HostMethod method) const noexcept;
+};
+
+/// The result of a single thread of the scaling benchmark.
+struct ThreadResult
+{
+    int cpu = -1;                 ///< The CPU the thread was pinned to or -1 if not pinned.
+    uint64_t num_executions = 0;  ///< The number of executions.
+    double throughput = 0;        ///< The number of executions per second.
+};
+
+/// The result of the multi-threaded scaling benchmark.
+struct ScalingResult
+{
+    int64_t gas_used = 0;                 ///< The amount of gas used by a single execution.
+    double single_thread_throughput = 0;  ///< The executions per second of a single thread.
+    std::vector<ThreadResult> threads;    ///< The results of the concurrent threads.
+
+    /// The aggregate number of executions per second of all the threads.
+    double throughput() const noexcept
+    {
+        double sum = 0;
+        for (const auto& t : threads)
+            sum += t.throughput;
+        return sum;
+    }
+
+    /// The aggregate throughput relative to the ideal linear scaling of a single thread.
+    double efficiency() const noexcept
+    {
+        const auto ideal = single_thread_throughput * static_cast<double>(threads.size());
+        return ideal > 0 ? throughput() / ideal : 0;
+    }
+};
+
+/// The state of the accounts (see FlatMockedHost::accounts).
+using State = FlatMockedHost::AccountMap;
+
+/// Loads the state from the file: the binary snapshot or the JSON state
+/// (see write_state_snapshot() and parse_json_state()).
+///
+/// @throws std::system_error      If the file cannot be read.
+/// @throws std::invalid_argument  In case of invalid state.
+State load_state(const std::string& path);
+
+/// Decodes the binary state snapshot.
+///
+/// The hash tables are reserved up front for the number of accounts and storage slots
+/// so the bulk insert does not rehash.
+///
+/// @throws std::invalid_argument  In case of invalid snapshot,
+///                                including duplicate accounts or storage slots.
+State load_state_snapshot(bytes_view snapshot);
+
+/// Writes the binary state snapshot.
+///
+/// The snapshot starts with an 8-byte header (the magic "EVMCSTA" and the format version)
+/// followed by the number of accounts and the accounts sorted by address.
+/// The account record consists of the address, the nonce, the balance, the code hash,
+/// the code size, the number of storage slots, the code and the storage slots
+/// (the key and the current value) sorted by key. The integers are 64-bit little-endian.
+void write_state_snapshot(std::ostream& out, const State& state);
+
+/// Parses the JSON state.
+///
+/// The JSON state is the object mapping the account addresses to the account objects with
+/// the optional members: "nonce", "balance", "code", "codehash" and "storage" (the object
+/// mapping the keys to the values). The values are hex strings, the nonce and the balance
+/// can also be numbers.
+///
+/// @throws std::invalid_argument  In case of invalid JSON state.
+State parse_json_state(std::string_view json);
+
+/// The options of the run() command.
+struct RunOptions
+{
+    /// Create new contract out of the code and then execute this contract with the input.
+    bool create = false;
+
+    /// The initial state of the accounts. Moved into the host of the execution. Empty if null.
+    State* state = nullptr;
+
+    /// Benchmark the execution time with the given configuration.
+    std::optional<BenchOptions> bench;
+
+    /// The output stream for the recording of the host callbacks (see RecordingHost).
+    /// Only the executions are recorded, not the benchmark iterations. Not recorded if null.
+    std::ostream* record = nullptr;
+
+    /// The host replaying the recorded callbacks instead of the MockedHost state.
+    /// The benchmark iterations rewind the replay to the start of the execution.
+    ReplayHost* replay = nullptr;
+};
+
+/// The read-only view of the file contents.
+///
+/// The file is memory-mapped where supported (POSIX), so the contents are not copied
+/// and the pages are loaded lazily. Otherwise, the file is read into memory.
+class MappedFile
+{
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    bytes m_buffer;  ///< The file contents if the file is not memory-mapped.
+
+public:
+    /// Maps the file at the path.
+    ///
+    /// @throws std::system_error  If the file cannot be opened or mapped.
+    explicit MappedFile(const std::string& path);
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&&) = delete;
+    ~MappedFile();
+
+    /// The file contents. Valid as long as the MappedFile object is alive.
+    bytes_view data() const noexcept { return {m_data, m_size}; }
+};
+
+/// Decodes the hex-encoded file contents. The whitespace in the file is ignored.
+///
+/// The file is memory-mapped and decoded in blocks of hex digits, falling back to
+/// the character-by-character decoding only around the whitespace.
+///
+/// @throws std::system_error      If the file cannot be read.
+/// @throws std::invalid_argument  In case of invalid hex in the file.
+bytes load_hex_file(const std::string& path);
+
+/// The benchmark case of a corpus.
+struct BenchCase
+{
+    std::string name;  ///< The name of the case.
+    bytes code;        ///< The code to execute.
+    bytes input;       ///< The input of the execution.
+
+    /// The expected gas used by the execution. Not checked if not set.
+    std::optional<int64_t> expected_gas;
+};
+
+/// The options of the synthetic benchmark corpus generator.
+struct BenchGenOptions
+{
+    /// The EVM revision of the gas costs. Berlin or later.
+    evmc_revision rev = EVMC_LATEST_STABLE_REVISION;
+
+    /// The gas limit every program must fit into.
+    int64_t gas_limit = 1000000;
+
+    /// The maximum number of loop iterations of a program.
+    uint32_t max_iterations = 1000000;
+
+    /// The size in bytes of the data: the memory region, the hashed data, the logged data
+    /// and the returned data.
+    uint32_t size = 1024;
+};
+
+/// The options of the bench_corpus() command.
+struct CorpusBenchOptions
+{
+    /// The benchmark configuration of every case. The state is always restored after every
+    /// execution (see BenchOptions::isolate_state).
+    BenchOptions bench;
+
+    /// The input stream of the baseline results in JSON (as written to #results). Not used if null.
+    std::istream* baseline = nullptr;
+
+    /// The relative slowdown against the baseline reported as a regression.
+    double threshold = 0.05;
+
+    /// The output stream for the results in JSON. Not written if null.
+    std::ostream* results = nullptr;
+
+    /// Compare the executions of every VM with the executions of the first VM
+    /// (see diff_executions()).
+    bool diff = false;
+};
+
+/// Loads the benchmark corpus from the directory.
+///
+/// Every `NAME.hex` file defines the case NAME with the hex-encoded code.
+/// The optional `NAME.input.hex` file contains the hex-encoded input of the case.
+/// The optional `NAME.gas` file contains the expected gas used as a decimal number.
+/// The whitespace in the files is ignored. The cases are sorted by name.
+///
+/// @throws std::invalid_argument  In case of invalid hex or gas in a file.
+std::vector<BenchCase> load_corpus(const std::string& dir);
+
+/// Writes the benchmark corpus to the directory in the format read by load_corpus().
+///
+/// @throws std::system_error  If a file cannot be written.
+void save_corpus(const std::string& dir, const std::vector<BenchCase>& cases);
+
+/// Generates the synthetic micro-benchmark programs stressing specific paths of the VM:
+/// arithmetic loop, MLOAD/MSTORE with memory expansion, KECCAK256, hot and cold
+/// SLOAD/SSTORE, CALL, LOG2 and large RETURN data.
+///
+/// The number of loop iterations of every program is the maximum fitting into the gas limit.
+/// The expected gas of the programs is computed from the gas costs of the revision
+/// assuming the empty initial state and the host returning no gas left from the calls
+/// (as the MockedHost does).
+///
+/// @throws std::invalid_argument  In case of unsupported revision or too low gas limit.
+std::vector<BenchCase> generate_bench_corpus(const BenchGenOptions& options);
+
+/// Benchmarks every case of the corpus on every VM and writes the comparison matrix
+/// of execution times and gas rates to the output.
+///
+/// @param vms      The VMs to benchmark with their names (e.g. the --vm configs).
+/// @param cases    The benchmark cases.
+/// @param rev      The EVM revision.
+/// @param gas      The execution gas limit.
+/// @param options  The corpus benchmark options.
+/// @param out      The output stream.
+/// @return         The exit code: 0 if successful, 1 if a regression against the baseline
+///                 or a difference between the VM executions has been detected.
+int bench_corpus(std::vector<std::pair<std::string, VM>>& vms,
+                 const std::vector<BenchCase>& cases,
+                 evmc_revision rev,
+                 int64_t gas,
+                 const CorpusBenchOptions& options,
+                 std::ostream& out);
+
+/// Computes the statistics of the given benchmark samples.
+///
+/// @param samples  The samples in nanoseconds. Must not be empty.
+BenchStats compute_stats(std::vector<double> samples);
+
+/// Benchmarks the execution of the code.
+///
+/// @param host     The host to execute the code with.
+/// @param vm       The VM to benchmark.
+/// @param rev      The EVM revision.
+/// @param msg      The message to execute.
+/// @param code     The code to execute.
+/// @param options  The benchmark configuration.
+/// @param reset    The optional function restoring the host state after every execution.
+/// @return         The benchmark result with the collected samples.
+BenchResult measure(Host& host,
+                    VM& vm,
+                    evmc_revision rev,
+                    const evmc_message& msg,
+                    bytes_view code,
+                    const BenchOptions& options,
+                    const std::function<void()>& reset = {});
+
+/// Measures how the execution throughput scales with the number of threads.
+///
+/// The code is executed repeatedly on a single thread and then concurrently on
+/// BenchOptions::num_threads threads, each phase for BenchOptions::num_samples times
+/// BenchOptions::sample_time. All threads share the VM instance, so it must be thread-safe.
+/// Every thread has its own copy of the host state and restores it after every execution
+/// if BenchOptions::isolate_state is set.
+///
+/// @param vm       The VM to benchmark.
+/// @param rev      The EVM revision.
+/// @param msg      The message to execute.
+/// @param code     The code to execute.
+/// @param state    The initial host state copied to every thread.
+/// @param options  The benchmark configuration.
+/// @return         The throughput of the single thread and of every concurrent thread.
+ScalingResult measure_scaling(VM& vm,
+                              evmc_revision rev,
+                              const evmc_message& msg,
+                              bytes_view code,
+                              const FlatMockedHost& state,
+                              const BenchOptions& options);
+
+/// Writes the benchmark result as a machine-readable report.
+void write_report(std::ostream& out, ReportFormat format, const BenchResult& result);
+
+/// Executes the code (optionally benchmarking it) and writes the summary to the output.
+int run(VM& vm,
+        evmc_revision rev,
+        int64_t gas,
+        bytes_view code,
+        bytes_view input,
+        const RunOptions& options,
+        std::ostream& out);
+
+/// @copybrief run()
+///
+/// The variant using the default benchmark configuration if @p bench is true.
 int run(VM& vm,
         evmc_revision rev,
         int64_t gas,
@@ -16,4 +859,80 @@ int run(VM& vm,
         bool create,
         bool bench,
         std::ostream& out);
+
+/// Executes the message on two VMs, each starting from a copy of the state,
+/// and compares the executions.
+///
+/// The status, the gas left, the gas refund, the output, the storage after the execution
+/// and the emitted logs are compared.
+///
+/// @return  The descriptions of the differences, empty if the executions are equivalent.
+std::vector<std::string> diff_executions(VM& vm1,
+                                         VM& vm2,
+                                         evmc_revision rev,
+                                         const evmc_message& msg,
+                                         bytes_view code,
+                                         const FlatMockedHost& state);
+
+/// Executes the code on two VMs from identical initial states, writes the differences
+/// of the executions (see diff_executions()) and the execution time ratio of the VMs.
+///
+/// The execution times are measured with RunOptions::bench configuration (the default one
+/// if not set). Contract creation and host recording and replay are not supported.
+///
+/// @return  0 if the executions are equivalent, 1 otherwise.
+int run_diff(VM& vm1,
+             VM& vm2,
+             evmc_revision rev,
+             int64_t gas,
+             bytes_view code,
+             bytes_view input,
+             const RunOptions& options,
+             std::ostream& out);
+
+/// Serves the execution requests read from the input stream on the warm VM
+/// until the end of the input.
+///
+/// The requests and the responses are binary frames prefixed with the 32-bit frame size.
+/// The request frame: the request id (64-bit), the revision (32-bit), the gas limit (64-bit),
+/// the length-prefixed code, the length-prefixed input and the length-prefixed path of the
+/// state file (see load_state(), the empty state if empty). The state files are loaded once
+/// and every execution starts from the loaded state.
+/// The response frame: the request id, the status code (32-bit), the gas left (64-bit),
+/// the gas refund (64-bit) and the length-prefixed output. The responses are written in the
+/// order of the requests. In case of invalid request (e.g. unknown revision or invalid
+/// state file) the status code is EVMC_REJECTED and the output is the error message.
+/// The integers are little-endian, the length prefixes are 32-bit.
+/// The request frames larger than 64 MiB are rejected as malformed.
+///
+/// The input is read and the output is written by separate threads, so the I/O is pipelined
+/// with the executions. The input stream is untied from the output stream while serving.
+///
+/// If the execution fails with an exception, serve() stops reading and rethrows it once the
+/// reader thread is done. The reader thread may be blocked waiting for the input: the
+/// stop_input callback should unblock it, e.g. by shutting down the reading side of the socket.
+/// Without it (e.g. for the standard input) serve() returns only after the next request frame
+/// or the end of the input is read.
+///
+/// @param vm          The VM.
+/// @param in          The input stream of the request frames.
+/// @param out         The output stream of the response frames.
+/// @param stop_input  The callback unblocking the reads of the input, optional.
+/// @return  The number of served requests.
+/// @throws std::invalid_argument  In case of malformed request frame.
+uint64_t serve(VM& vm,
+               std::istream& in,
+               std::ostream& out,
+               const std::function<void()>& stop_input = {});
+
+/// Serves the execution requests (see serve()) from the connections to the Unix domain socket.
+///
+/// The connections are served one after another. The socket file is created at the path
+/// (replacing the existing file) and removed when done. POSIX only.
+///
+/// @param vm               The VM.
+/// @param path             The path of the socket file.
+/// @param num_connections  The number of connections to serve, unlimited if 0.
+/// @throws std::system_error  If the socket cannot be created.
+void serve_unix_socket(VM& vm, const std::string& path, uint64_t num_connections = 0);
 }  // namespace evmc::tooling
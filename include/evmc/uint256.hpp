@@ -0,0 +1,542 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+#pragma once
+
+#include <evmc/evmc.hpp>
+#include <optional>
+#include <string_view>
+
+namespace evmc
+{
+/// The 256-bit unsigned integer type with the arithmetic of modulo 2^256.
+///
+/// This is the native arithmetic counterpart of the big-endian byte container evmc::uint256be.
+/// The value is kept in four 64-bit limbs, the least significant first.
+/// All operations are constexpr and do not allocate memory.
+struct uint256
+{
+    /// The 64-bit limbs, the least significant first.
+    uint64_t words[4]{};
+
+    /// Default constructor, initializes the value to zero.
+    constexpr uint256() noexcept = default;
+
+    /// Converting constructor from a 64-bit value.
+    constexpr uint256(uint64_t v) noexcept : words{v, 0, 0, 0} {}
+
+    /// Constructs the value from 64-bit limbs, the most significant first.
+    constexpr uint256(uint64_t w3, uint64_t w2, uint64_t w1, uint64_t w0) noexcept
+      : words{w0, w1, w2, w3}
+    {}
+
+    /// Converting constructor from the big-endian bytes representation.
+    constexpr explicit uint256(const evmc_uint256be& be) noexcept
+      : words{load64be(&be.bytes[24]), load64be(&be.bytes[16]), load64be(&be.bytes[8]),
+              load64be(&be.bytes[0])}
+    {}
+
+    /// Converts the value to the big-endian bytes representation.
+    constexpr explicit operator uint256be() const noexcept
+    {
+        uint256be be;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            const auto w = words[3 - i];
+            for (size_t j = 0; j < 8; ++j)
+                be.bytes[i * 8 + j] = static_cast<uint8_t>(w >> (56 - 8 * j));
+        }
+        return be;
+    }
+
+    /// Explicit operator converting to bool, true if the value is not zero.
+    constexpr explicit operator bool() const noexcept
+    {
+        return (words[0] | words[1] | words[2] | words[3]) != 0;
+    }
+
+    /// Truncates the value to the least significant 64 bits.
+    constexpr explicit operator uint64_t() const noexcept { return words[0]; }
+
+    /// Access the limb of the given index, the least significant first.
+    constexpr uint64_t& operator[](size_t i) noexcept { return words[i]; }
+
+    /// Access the limb of the given index, the least significant first.
+    constexpr const uint64_t& operator[](size_t i) const noexcept { return words[i]; }
+};
+
+namespace detail
+{
+/// The value and the carry (or borrow) bit of an addition (or subtraction).
+struct result_with_carry
+{
+    uint64_t value;  ///< The result value.
+    bool carry;      ///< The carry bit.
+};
+
+#if defined(_MSC_VER) && defined(_M_X64)
+inline result_with_carry addc_runtime(uint64_t x, uint64_t y, bool carry) noexcept
+{
+    unsigned long long s = 0;
+    const auto c = _addcarry_u64(carry, x, y, &s);
+    return {s, c != 0};
+}
+
+inline result_with_carry subc_runtime(uint64_t x, uint64_t y, bool borrow) noexcept
+{
+    unsigned long long d = 0;
+    const auto b = _subborrow_u64(borrow, x, y, &d);
+    return {d, b != 0};
+}
+#endif
+
+/// Adds the values and the carry bit.
+inline constexpr result_with_carry addc(uint64_t x, uint64_t y, bool carry = false) noexcept
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    if (use_runtime_impl())
+        return addc_runtime(x, y, carry);
+#endif
+    const auto s = x + y;
+    const auto carry1 = s < x;
+    const auto t = s + carry;
+    const auto carry2 = t < s;
+    return {t, carry1 || carry2};
+}
+
+/// Subtracts the value and the borrow bit.
+inline constexpr result_with_carry subc(uint64_t x, uint64_t y, bool borrow = false) noexcept
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    if (use_runtime_impl())
+        return subc_runtime(x, y, borrow);
+#endif
+    const auto d = x - y;
+    const auto borrow1 = x < y;
+    const auto e = d - borrow;
+    const auto borrow2 = d < e;
+    return {e, borrow1 || borrow2};
+}
+
+/// Returns the number of leading zero bits of the 32-bit value (32 for zero).
+inline constexpr unsigned clz32(uint32_t x) noexcept
+{
+    unsigned n = 0;
+    for (uint32_t mask = 0x80000000; mask != 0 && (x & mask) == 0; mask >>= 1)
+        ++n;
+    return n;
+}
+
+/// The quotient and the remainder of a division.
+struct div_result
+{
+    uint256 quot;  ///< The quotient.
+    uint256 rem;   ///< The remainder.
+};
+
+/// Divides @p u by the non-zero @p v.
+///
+/// This is the Knuth's Algorithm D (TAOCP 4.3.1) on 32-bit digits
+/// so that it only needs the 64-bit arithmetic. Based on divmnu64 from Hacker's Delight.
+inline constexpr div_result udivrem(const uint256& u, const uint256& v) noexcept
+{
+    constexpr size_t m = 8;  // The number of the 32-bit digits of the dividend.
+    constexpr uint64_t b = uint64_t{1} << 32;
+    uint32_t un[m + 1]{};
+    uint32_t vn[m]{};
+    for (size_t i = 0; i < 4; ++i)
+    {
+        un[2 * i] = static_cast<uint32_t>(u[i]);
+        un[2 * i + 1] = static_cast<uint32_t>(u[i] >> 32);
+        vn[2 * i] = static_cast<uint32_t>(v[i]);
+        vn[2 * i + 1] = static_cast<uint32_t>(v[i] >> 32);
+    }
+
+    size_t n = m;  // The number of the significant digits of the divisor.
+    while (n > 0 && vn[n - 1] == 0)
+        --n;
+
+    uint32_t q[m]{};
+    if (n == 1)
+    {
+        // The short division.
+        uint64_t r = 0;
+        for (size_t j = m; j-- > 0;)
+        {
+            r = (r << 32) | un[j];
+            q[j] = static_cast<uint32_t>(r / vn[0]);
+            r %= vn[0];
+        }
+        un[0] = static_cast<uint32_t>(r);
+        for (size_t i = 1; i < m; ++i)
+            un[i] = 0;
+    }
+    else
+    {
+        // Normalize the divisor to have the top bit set and shift the dividend by the same amount.
+        const auto s = clz32(vn[n - 1]);
+        if (s != 0)
+        {
+            for (size_t i = n - 1; i > 0; --i)
+                vn[i] = (vn[i] << s) | (vn[i - 1] >> (32 - s));
+            vn[0] <<= s;
+            un[m] = un[m - 1] >> (32 - s);
+            for (size_t i = m - 1; i > 0; --i)
+                un[i] = (un[i] << s) | (un[i - 1] >> (32 - s));
+            un[0] <<= s;
+        }
+
+        for (size_t j = m - n + 1; j-- > 0;)
+        {
+            // Estimate the quotient digit.
+            const auto num = (uint64_t{un[j + n]} << 32) | un[j + n - 1];
+            auto qhat = num / vn[n - 1];
+            auto rhat = num % vn[n - 1];
+            while (qhat >= b || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2]))
+            {
+                --qhat;
+                rhat += vn[n - 1];
+                if (rhat >= b)
+                    break;
+            }
+
+            // Multiply and subtract.
+            int64_t k = 0;
+            int64_t t = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                const auto p = qhat * vn[i];
+                t = static_cast<int64_t>(un[i + j] - static_cast<uint64_t>(k) - (p & 0xffffffff));
+                un[i + j] = static_cast<uint32_t>(t);
+                k = static_cast<int64_t>(p >> 32) - (t >> 32);
+            }
+            t = static_cast<int64_t>(un[j + n] - static_cast<uint64_t>(k));
+            un[j + n] = static_cast<uint32_t>(t);
+
+            q[j] = static_cast<uint32_t>(qhat);
+            if (t < 0)
+            {
+                // Subtracted too much, add back.
+                --q[j];
+                uint64_t c = 0;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    c += uint64_t{un[i + j]} + vn[i];
+                    un[i + j] = static_cast<uint32_t>(c);
+                    c >>= 32;
+                }
+                un[j + n] = static_cast<uint32_t>(un[j + n] + c);
+            }
+        }
+
+        // Unnormalize the remainder.
+        for (size_t i = 0; i < n; ++i)
+            un[i] = s != 0 ? (un[i] >> s) | (un[i + 1] << (32 - s)) : un[i];
+        for (size_t i = n; i < m; ++i)
+            un[i] = 0;
+    }
+
+    div_result r;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        r.quot[i] = (uint64_t{q[2 * i + 1]} << 32) | q[2 * i];
+        r.rem[i] = (uint64_t{un[2 * i + 1]} << 32) | un[2 * i];
+    }
+    return r;
+}
+}  // namespace detail
+
+/// The "equal to" comparison operator for the evmc::uint256 type.
+inline constexpr bool operator==(const uint256& x, const uint256& y) noexcept
+{
+    return ((x[0] ^ y[0]) | (x[1] ^ y[1]) | (x[2] ^ y[2]) | (x[3] ^ y[3])) == 0;
+}
+
+/// The "not equal to" comparison operator for the evmc::uint256 type.
+inline constexpr bool operator!=(const uint256& x, const uint256& y) noexcept
+{
+    return !(x == y);
+}
+
+/// The "less than" comparison operator for the evmc::uint256 type.
+inline constexpr bool operator<(const uint256& x, const uint256& y) noexcept
+{
+    // Compute the borrow of x - y.
+    bool borrow = false;
+    for (size_t i = 0; i < 4; ++i)
+        borrow = detail::subc(x[i], y[i], borrow).carry;
+    return borrow;
+}
+
+/// The "greater than" comparison operator for the evmc::uint256 type.
+inline constexpr bool operator>(const uint256& x, const uint256& y) noexcept
+{
+    return y < x;
+}
+
+/// The "less than or equal to" comparison operator for the evmc::uint256 type.
+inline constexpr bool operator<=(const uint256& x, const uint256& y) noexcept
+{
+    return !(y < x);
+}
+
+/// The "greater than or equal to" comparison operator for the evmc::uint256 type.
+inline constexpr bool operator>=(const uint256& x, const uint256& y) noexcept
+{
+    return !(x < y);
+}
+
+/// Addition modulo 2^256.
+inline constexpr uint256 operator+(const uint256& x, const uint256& y) noexcept
+{
+    uint256 z;
+    bool carry = false;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const auto r = detail::addc(x[i], y[i], carry);
+        z[i] = r.value;
+        carry = r.carry;
+    }
+    return z;
+}
+
+/// Subtraction modulo 2^256.
+inline constexpr uint256 operator-(const uint256& x, const uint256& y) noexcept
+{
+    uint256 z;
+    bool borrow = false;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const auto r = detail::subc(x[i], y[i], borrow);
+        z[i] = r.value;
+        borrow = r.carry;
+    }
+    return z;
+}
+
+/// Negation modulo 2^256 (the two's complement).
+inline constexpr uint256 operator-(const uint256& x) noexcept
+{
+    return uint256{} - x;
+}
+
+/// Multiplication modulo 2^256.
+inline constexpr uint256 operator*(const uint256& x, const uint256& y) noexcept
+{
+    uint256 z;
+    for (size_t j = 0; j < 4; ++j)
+    {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < 4 - j; ++i)
+        {
+            const auto p = detail::umul(x[i], y[j]);
+            const auto s1 = detail::addc(p.lo, z[i + j]);
+            const auto s2 = detail::addc(s1.value, carry);
+            z[i + j] = s2.value;
+            carry = p.hi + s1.carry + s2.carry;
+        }
+    }
+    return z;
+}
+
+/// Computes the quotient and the remainder of the division.
+/// The division by zero results in zero quotient and remainder, as in the EVM.
+inline constexpr detail::div_result udivrem(const uint256& x, const uint256& y) noexcept
+{
+    if (!y)
+        return {};
+    return detail::udivrem(x, y);
+}
+
+/// Division. The division by zero results in zero, as in the EVM DIV instruction.
+inline constexpr uint256 operator/(const uint256& x, const uint256& y) noexcept
+{
+    return udivrem(x, y).quot;
+}
+
+/// Modulo. The modulo by zero results in zero, as in the EVM MOD instruction.
+inline constexpr uint256 operator%(const uint256& x, const uint256& y) noexcept
+{
+    return udivrem(x, y).rem;
+}
+
+/// Bitwise AND.
+inline constexpr uint256 operator&(const uint256& x, const uint256& y) noexcept
+{
+    return {x[3] & y[3], x[2] & y[2], x[1] & y[1], x[0] & y[0]};
+}
+
+/// Bitwise OR.
+inline constexpr uint256 operator|(const uint256& x, const uint256& y) noexcept
+{
+    return {x[3] | y[3], x[2] | y[2], x[1] | y[1], x[0] | y[0]};
+}
+
+/// Bitwise XOR.
+inline constexpr uint256 operator^(const uint256& x, const uint256& y) noexcept
+{
+    return {x[3] ^ y[3], x[2] ^ y[2], x[1] ^ y[1], x[0] ^ y[0]};
+}
+
+/// Bitwise NOT.
+inline constexpr uint256 operator~(const uint256& x) noexcept
+{
+    return {~x[3], ~x[2], ~x[1], ~x[0]};
+}
+
+/// Left shift. Shifting by 256 bits or more results in zero.
+inline constexpr uint256 operator<<(const uint256& x, uint64_t shift) noexcept
+{
+    if (shift >= 256)
+        return {};
+    const auto word_shift = static_cast<size_t>(shift / 64);
+    const auto bit_shift = static_cast<unsigned>(shift % 64);
+    uint256 z;
+    for (size_t i = word_shift; i < 4; ++i)
+    {
+        z[i] = x[i - word_shift] << bit_shift;
+        if (bit_shift != 0 && i > word_shift)
+            z[i] |= x[i - word_shift - 1] >> (64 - bit_shift);
+    }
+    return z;
+}
+
+/// Right shift. Shifting by 256 bits or more results in zero.
+inline constexpr uint256 operator>>(const uint256& x, uint64_t shift) noexcept
+{
+    if (shift >= 256)
+        return {};
+    const auto word_shift = static_cast<size_t>(shift / 64);
+    const auto bit_shift = static_cast<unsigned>(shift % 64);
+    uint256 z;
+    for (size_t i = 0; i < 4 - word_shift; ++i)
+    {
+        z[i] = x[i + word_shift] >> bit_shift;
+        if (bit_shift != 0 && i + word_shift + 1 < 4)
+            z[i] |= x[i + word_shift + 1] << (64 - bit_shift);
+    }
+    return z;
+}
+
+/// Left shift by the 256-bit amount.
+inline constexpr uint256 operator<<(const uint256& x, const uint256& shift) noexcept
+{
+    return (shift[3] | shift[2] | shift[1]) != 0 ? uint256{} : x << shift[0];
+}
+
+/// Right shift by the 256-bit amount.
+inline constexpr uint256 operator>>(const uint256& x, const uint256& shift) noexcept
+{
+    return (shift[3] | shift[2] | shift[1]) != 0 ? uint256{} : x >> shift[0];
+}
+
+/// Addition assignment operator.
+inline constexpr uint256& operator+=(uint256& x, const uint256& y) noexcept
+{
+    return x = x + y;
+}
+
+/// Subtraction assignment operator.
+inline constexpr uint256& operator-=(uint256& x, const uint256& y) noexcept
+{
+    return x = x - y;
+}
+
+/// Multiplication assignment operator.
+inline constexpr uint256& operator*=(uint256& x, const uint256& y) noexcept
+{
+    return x = x * y;
+}
+
+/// Division assignment operator.
+inline constexpr uint256& operator/=(uint256& x, const uint256& y) noexcept
+{
+    return x = x / y;
+}
+
+/// Modulo assignment operator.
+inline constexpr uint256& operator%=(uint256& x, const uint256& y) noexcept
+{
+    return x = x % y;
+}
+
+/// Bitwise AND assignment operator.
+inline constexpr uint256& operator&=(uint256& x, const uint256& y) noexcept
+{
+    return x = x & y;
+}
+
+/// Bitwise OR assignment operator.
+inline constexpr uint256& operator|=(uint256& x, const uint256& y) noexcept
+{
+    return x = x | y;
+}
+
+/// Bitwise XOR assignment operator.
+inline constexpr uint256& operator^=(uint256& x, const uint256& y) noexcept
+{
+    return x = x ^ y;
+}
+
+/// Left shift assignment operator.
+inline constexpr uint256& operator<<=(uint256& x, uint64_t shift) noexcept
+{
+    return x = x << shift;
+}
+
+/// Right shift assignment operator.
+inline constexpr uint256& operator>>=(uint256& x, uint64_t shift) noexcept
+{
+    return x = x >> shift;
+}
+
+/// Parses the decimal or the 0x-prefixed hexadecimal number.
+///
+/// @return  The parsed value or std::nullopt if the input is not a valid number
+///          or the value does not fit 256 bits.
+constexpr std::optional<uint256> parse_uint256(std::string_view s) noexcept
+{
+    if (s.empty())
+        return {};
+
+    uint256 x;
+    if (s.size() >= 2 && s[0] == '0' && s[1] == 'x')
+    {
+        s.remove_prefix(2);
+        if (s.empty())
+            return {};
+        for (const auto c : s)
+        {
+            const auto d = internal::from_hex_digit(c);
+            if (d < 0 || (x[3] >> 60) != 0)
+                return {};
+            x = (x << 4) | uint256{static_cast<uint64_t>(d)};
+        }
+        return x;
+    }
+
+    constexpr auto max_before_mul = ~uint256{} / 10;
+    for (const auto c : s)
+    {
+        if (c < '0' || c > '9')
+            return {};
+        const auto d = static_cast<uint64_t>(c - '0');
+        if (x > max_before_mul)
+            return {};
+        const auto y = x * 10 + d;
+        if (y < d)
+            return {};
+        x = y;
+    }
+    return x;
+}
+
+namespace literals
+{
+/// Literal for evmc::uint256, the decimal or the 0x-prefixed hexadecimal number.
+constexpr uint256 operator""_u256(const char* s) noexcept
+{
+    return parse_uint256(s).value();
+}
+}  // namespace literals
+}  // namespace evmc
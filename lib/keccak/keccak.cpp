@@ -0,0 +1,114 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "keccakf1600.hpp"
+#include <evmc/keccak.hpp>
+
+namespace evmc
+{
+namespace keccak_internal
+{
+namespace
+{
+/// The lane operations for a single state in the general purpose registers.
+struct Scalar
+{
+    using V = uint64_t;
+    static constexpr size_t width = 1;
+
+    static V zero() noexcept { return 0; }
+
+    static V load(const uint64_t* words) noexcept { return words[0]; }
+
+    static void store(uint64_t* words, V x) noexcept { words[0] = x; }
+
+    static V xor2(V a, V b) noexcept { return a ^ b; }
+
+    static V xor5(V a, V b, V c, V d, V e) noexcept { return a ^ b ^ c ^ d ^ e; }
+
+    template <int N>
+    static V rol(V x) noexcept
+    {
+        return (x << N) | (x >> (64 - N));
+    }
+
+    static V chi(V a, V b, V c) noexcept { return a ^ (~b & c); }
+
+    static V xor_rc(V a, uint64_t rc) noexcept { return a ^ rc; }
+};
+
+void keccak256_x1(const uint8_t* const data[1],
+                  const size_t size[1],
+                  uint8_t* const out[1]) noexcept
+{
+    keccak256_lanes<Scalar>(data, size, out);
+}
+
+using BatchFn = void (*)(const uint8_t* const[], const size_t[], uint8_t* const[]) noexcept;
+
+/// The multi-buffer implementation hashing the given number of inputs at once.
+struct Batch
+{
+    size_t width;
+    BatchFn fn;
+};
+
+/// The multi-buffer implementations available on the CPU, the widest first.
+/// The last one is the scalar fallback.
+struct Batches
+{
+    Batch items[3];
+    size_t size;
+};
+
+Batches detect_batches() noexcept
+{
+    Batches batches{};
+#if defined(EVMC_KECCAK_X86_SIMD)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        batches.items[batches.size++] = {8, keccak256_x8_avx512};
+    if (__builtin_cpu_supports("avx2"))
+        batches.items[batches.size++] = {4, keccak256_x4_avx2};
+#endif
+    batches.items[batches.size++] = {1, keccak256_x1};
+    return batches;
+}
+}  // namespace
+}  // namespace keccak_internal
+
+bytes32 keccak256(bytes_view data) noexcept
+{
+    bytes32 hash;
+    const uint8_t* const in[]{data.data()};
+    const size_t size[]{data.size()};
+    uint8_t* const out[]{hash.bytes};
+    keccak_internal::keccak256_x1(in, size, out);
+    return hash;
+}
+
+void keccak256(const bytes_view inputs[], bytes32 outputs[], size_t n) noexcept
+{
+    static const auto batches = keccak_internal::detect_batches();
+
+    size_t i = 0;
+    for (size_t b = 0; b < batches.size; ++b)
+    {
+        const auto [width, fn] = batches.items[b];
+        for (; n - i >= width; i += width)
+        {
+            const uint8_t* in[8];
+            size_t size[8];
+            uint8_t* out[8];
+            for (size_t l = 0; l < width; ++l)
+            {
+                in[l] = inputs[i + l].data();
+                size[l] = inputs[i + l].size();
+                out[l] = outputs[i + l].bytes;
+            }
+            fn(in, size, out);
+        }
+    }
+}
+}  // namespace evmc
@@ -0,0 +1,60 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+// Compiled with AVX2 enabled, called only if the CPU supports it.
+
+#include "keccakf1600.hpp"
+#include <immintrin.h>
+
+namespace evmc::keccak_internal
+{
+namespace
+{
+/// The lane operations for 4 states in the 256-bit vectors.
+struct Avx2
+{
+    using V = __m256i;
+    static constexpr size_t width = 4;
+
+    static V zero() noexcept { return _mm256_setzero_si256(); }
+
+    static V load(const uint64_t* words) noexcept
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words));
+    }
+
+    static void store(uint64_t* words, V x) noexcept
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(words), x);
+    }
+
+    static V xor2(V a, V b) noexcept { return _mm256_xor_si256(a, b); }
+
+    static V xor5(V a, V b, V c, V d, V e) noexcept
+    {
+        return xor2(xor2(xor2(a, b), xor2(c, d)), e);
+    }
+
+    template <int N>
+    static V rol(V x) noexcept
+    {
+        return _mm256_or_si256(_mm256_slli_epi64(x, N), _mm256_srli_epi64(x, 64 - N));
+    }
+
+    static V chi(V a, V b, V c) noexcept { return xor2(a, _mm256_andnot_si256(b, c)); }
+
+    static V xor_rc(V a, uint64_t rc) noexcept
+    {
+        return xor2(a, _mm256_set1_epi64x(static_cast<long long>(rc)));
+    }
+};
+}  // namespace
+
+void keccak256_x4_avx2(const uint8_t* const data[4],
+                       const size_t size[4],
+                       uint8_t* const out[4]) noexcept
+{
+    keccak256_lanes<Avx2>(data, size, out);
+}
+}  // namespace evmc::keccak_internal
@@ -0,0 +1,59 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+// Compiled with AVX-512F enabled, called only if the CPU supports it.
+
+#include "keccakf1600.hpp"
+#include <immintrin.h>
+
+namespace evmc::keccak_internal
+{
+namespace
+{
+/// The lane operations for 8 states in the 512-bit vectors.
+/// The native rotations and the ternary logic instructions shorten the rounds.
+struct Avx512
+{
+    using V = __m512i;
+    static constexpr size_t width = 8;
+
+    static V zero() noexcept { return _mm512_setzero_si512(); }
+
+    static V load(const uint64_t* words) noexcept { return _mm512_loadu_si512(words); }
+
+    static void store(uint64_t* words, V x) noexcept { _mm512_storeu_si512(words, x); }
+
+    static V xor2(V a, V b) noexcept { return _mm512_xor_si512(a, b); }
+
+    /// Computes a ^ b ^ c ^ d ^ e, 0x96 being the truth table of the 3-way XOR.
+    static V xor5(V a, V b, V c, V d, V e) noexcept
+    {
+        return _mm512_ternarylogic_epi64(_mm512_ternarylogic_epi64(a, b, c, 0x96), d, e, 0x96);
+    }
+
+    /// The zero-masking form with all lanes selected is the same rotation. Unlike
+    /// _mm512_rol_epi64() it avoids the bogus -Wuninitialized of the GCC 12 intrinsics.
+    template <int N>
+    static V rol(V x) noexcept
+    {
+        return _mm512_maskz_rol_epi64(0xff, x, N);
+    }
+
+    /// Computes a ^ (~b & c), 0xd2 being the truth table of this function.
+    static V chi(V a, V b, V c) noexcept { return _mm512_ternarylogic_epi64(a, b, c, 0xd2); }
+
+    static V xor_rc(V a, uint64_t rc) noexcept
+    {
+        return xor2(a, _mm512_set1_epi64(static_cast<long long>(rc)));
+    }
+};
+}  // namespace
+
+void keccak256_x8_avx512(const uint8_t* const data[8],
+                         const size_t size[8],
+                         uint8_t* const out[8]) noexcept
+{
+    keccak256_lanes<Avx512>(data, size, out);
+}
+}  // namespace evmc::keccak_internal
@@ -0,0 +1,213 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+/// @file
+/// The Keccak-f[1600] permutation and the Keccak-256 sponge generic over the state lane type.
+///
+/// The code is instantiated by each translation unit for its own instruction set
+/// (scalar, AVX2, AVX-512) with the Ops traits providing the lane operations:
+/// the vector types hold the same lane of the state of Ops::width independent hashes.
+/// Everything here has internal linkage so that the code compiled with the extended instruction
+/// sets never replaces the baseline one at link time.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace evmc::keccak_internal
+{
+/// The Keccak-256 rate in bytes, i.e. the size of the absorbed block.
+constexpr size_t rate = 136;
+
+/// The Keccak-256 rate in 64-bit words.
+constexpr size_t rate_words = rate / 8;
+
+void keccak256_x4_avx2(const uint8_t* const data[4],
+                       const size_t size[4],
+                       uint8_t* const out[4]) noexcept;
+
+void keccak256_x8_avx512(const uint8_t* const data[8],
+                         const size_t size[8],
+                         uint8_t* const out[8]) noexcept;
+
+namespace
+{
+constexpr uint64_t round_constants[24] = {
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000,
+    0x000000000000808b, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+    0x000000000000008a, 0x0000000000000088, 0x0000000080008009, 0x000000008000000a,
+    0x000000008000808b, 0x800000000000008b, 0x8000000000008089, 0x8000000000008003,
+    0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008,
+};
+
+/// Loads the little-endian 64-bit word. The pattern is recognized as a single load.
+inline uint64_t load_le64(const uint8_t* p) noexcept
+{
+    return uint64_t{p[0]} | (uint64_t{p[1]} << 8) | (uint64_t{p[2]} << 16) |
+           (uint64_t{p[3]} << 24) | (uint64_t{p[4]} << 32) | (uint64_t{p[5]} << 40) |
+           (uint64_t{p[6]} << 48) | (uint64_t{p[7]} << 56);
+}
+
+/// Stores the 64-bit word as little-endian.
+inline void store_le64(uint8_t* p, uint64_t x) noexcept
+{
+    for (size_t i = 0; i < 8; ++i)
+        p[i] = static_cast<uint8_t>(x >> (8 * i));
+}
+
+/// The Keccak-f[1600] permutation, all steps of a round unrolled.
+///
+/// The state lanes are indexed by x + 5 * y.
+template <typename Ops>
+inline void keccakf1600(typename Ops::V s[25]) noexcept
+{
+    using V = typename Ops::V;
+    for (const auto rc : round_constants)
+    {
+        // Theta.
+        const V c0 = Ops::xor5(s[0], s[5], s[10], s[15], s[20]);
+        const V c1 = Ops::xor5(s[1], s[6], s[11], s[16], s[21]);
+        const V c2 = Ops::xor5(s[2], s[7], s[12], s[17], s[22]);
+        const V c3 = Ops::xor5(s[3], s[8], s[13], s[18], s[23]);
+        const V c4 = Ops::xor5(s[4], s[9], s[14], s[19], s[24]);
+        const V d0 = Ops::xor2(c4, Ops::template rol<1>(c1));
+        const V d1 = Ops::xor2(c0, Ops::template rol<1>(c2));
+        const V d2 = Ops::xor2(c1, Ops::template rol<1>(c3));
+        const V d3 = Ops::xor2(c2, Ops::template rol<1>(c4));
+        const V d4 = Ops::xor2(c3, Ops::template rol<1>(c0));
+
+        // Rho and pi.
+        const V b0 = Ops::xor2(s[0], d0);
+        const V b1 = Ops::template rol<44>(Ops::xor2(s[6], d1));
+        const V b2 = Ops::template rol<43>(Ops::xor2(s[12], d2));
+        const V b3 = Ops::template rol<21>(Ops::xor2(s[18], d3));
+        const V b4 = Ops::template rol<14>(Ops::xor2(s[24], d4));
+        const V b5 = Ops::template rol<28>(Ops::xor2(s[3], d3));
+        const V b6 = Ops::template rol<20>(Ops::xor2(s[9], d4));
+        const V b7 = Ops::template rol<3>(Ops::xor2(s[10], d0));
+        const V b8 = Ops::template rol<45>(Ops::xor2(s[16], d1));
+        const V b9 = Ops::template rol<61>(Ops::xor2(s[22], d2));
+        const V b10 = Ops::template rol<1>(Ops::xor2(s[1], d1));
+        const V b11 = Ops::template rol<6>(Ops::xor2(s[7], d2));
+        const V b12 = Ops::template rol<25>(Ops::xor2(s[13], d3));
+        const V b13 = Ops::template rol<8>(Ops::xor2(s[19], d4));
+        const V b14 = Ops::template rol<18>(Ops::xor2(s[20], d0));
+        const V b15 = Ops::template rol<27>(Ops::xor2(s[4], d4));
+        const V b16 = Ops::template rol<36>(Ops::xor2(s[5], d0));
+        const V b17 = Ops::template rol<10>(Ops::xor2(s[11], d1));
+        const V b18 = Ops::template rol<15>(Ops::xor2(s[17], d2));
+        const V b19 = Ops::template rol<56>(Ops::xor2(s[23], d3));
+        const V b20 = Ops::template rol<62>(Ops::xor2(s[2], d2));
+        const V b21 = Ops::template rol<55>(Ops::xor2(s[8], d3));
+        const V b22 = Ops::template rol<39>(Ops::xor2(s[14], d4));
+        const V b23 = Ops::template rol<41>(Ops::xor2(s[15], d0));
+        const V b24 = Ops::template rol<2>(Ops::xor2(s[21], d1));
+
+        // Chi.
+        s[0] = Ops::chi(b0, b1, b2);
+        s[1] = Ops::chi(b1, b2, b3);
+        s[2] = Ops::chi(b2, b3, b4);
+        s[3] = Ops::chi(b3, b4, b0);
+        s[4] = Ops::chi(b4, b0, b1);
+        s[5] = Ops::chi(b5, b6, b7);
+        s[6] = Ops::chi(b6, b7, b8);
+        s[7] = Ops::chi(b7, b8, b9);
+        s[8] = Ops::chi(b8, b9, b5);
+        s[9] = Ops::chi(b9, b5, b6);
+        s[10] = Ops::chi(b10, b11, b12);
+        s[11] = Ops::chi(b11, b12, b13);
+        s[12] = Ops::chi(b12, b13, b14);
+        s[13] = Ops::chi(b13, b14, b10);
+        s[14] = Ops::chi(b14, b10, b11);
+        s[15] = Ops::chi(b15, b16, b17);
+        s[16] = Ops::chi(b16, b17, b18);
+        s[17] = Ops::chi(b17, b18, b19);
+        s[18] = Ops::chi(b18, b19, b15);
+        s[19] = Ops::chi(b19, b15, b16);
+        s[20] = Ops::chi(b20, b21, b22);
+        s[21] = Ops::chi(b21, b22, b23);
+        s[22] = Ops::chi(b22, b23, b24);
+        s[23] = Ops::chi(b23, b24, b20);
+        s[24] = Ops::chi(b24, b20, b21);
+
+        // Iota.
+        s[0] = Ops::xor_rc(s[0], rc);
+    }
+}
+
+/// Computes the Keccak-256 hashes of Ops::width inputs, each in its own lane.
+///
+/// The permutation runs as many times as the longest input needs. The lanes of the shorter inputs
+/// absorb zero blocks after their hash has been extracted.
+template <typename Ops>
+inline void keccak256_lanes(const uint8_t* const data[],
+                            const size_t size[],
+                            uint8_t* const out[]) noexcept
+{
+    using V = typename Ops::V;
+    constexpr auto width = Ops::width;
+    static constexpr uint8_t zero_block[rate]{};
+
+    // The final block of each input with the padding applied.
+    uint8_t last_block[width][rate];
+    size_t num_blocks[width];
+    size_t max_num_blocks = 0;
+    for (size_t l = 0; l < width; ++l)
+    {
+        const auto tail = size[l] % rate;
+        if (tail != 0)
+            std::memcpy(last_block[l], &data[l][size[l] - tail], tail);
+        std::memset(&last_block[l][tail], 0, rate - tail);
+        last_block[l][tail] = 0x01;
+        last_block[l][rate - 1] |= 0x80;
+
+        num_blocks[l] = size[l] / rate + 1;
+        if (num_blocks[l] > max_num_blocks)
+            max_num_blocks = num_blocks[l];
+    }
+
+    V state[25];
+    for (auto& lane : state)
+        lane = Ops::zero();
+
+    for (size_t b = 0; b < max_num_blocks; ++b)
+    {
+        const uint8_t* block[width];
+        for (size_t l = 0; l < width; ++l)
+        {
+            if (b + 1 < num_blocks[l])
+                block[l] = &data[l][b * rate];
+            else if (b + 1 == num_blocks[l])
+                block[l] = last_block[l];
+            else
+                block[l] = zero_block;
+        }
+
+        for (size_t i = 0; i < rate_words; ++i)
+        {
+            uint64_t words[width];
+            for (size_t l = 0; l < width; ++l)
+                words[l] = load_le64(&block[l][i * 8]);
+            state[i] = Ops::xor2(state[i], Ops::load(words));
+        }
+
+        keccakf1600<Ops>(state);
+
+        for (size_t l = 0; l < width; ++l)
+        {
+            if (b + 1 != num_blocks[l])
+                continue;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                uint64_t words[width];
+                Ops::store(words, state[i]);
+                store_le64(&out[l][i * 8], words[l]);
+            }
+        }
+    }
+}
+}  // namespace
+}  // namespace evmc::keccak_internal
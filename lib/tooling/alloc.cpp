@@ -0,0 +1,20 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "alloc.hpp"
+#include <evmc/tooling.hpp>
+
+namespace evmc::tooling
+{
+namespace alloc_tracking
+{
+thread_local ThreadCounters counters{};
+bool hooks_installed = false;
+}  // namespace alloc_tracking
+
+bool alloc_tracking_available() noexcept
+{
+    return alloc_tracking::hooks_installed;
+}
+}  // namespace evmc::tooling
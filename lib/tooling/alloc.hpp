@@ -0,0 +1,57 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// The heap allocation tracking.
+///
+/// The counters are updated by the allocation hooks (alloc_hooks.cpp) which must be linked
+/// into the executable to interpose the allocation functions. The counters are thread-local,
+/// so the hooks do not need any synchronization.
+namespace evmc::tooling::alloc_tracking
+{
+/// The allocation scope: who is responsible for the allocations.
+enum Scope : uint8_t
+{
+    vm_scope,
+    host_scope,
+    num_scopes,
+};
+
+/// The allocation counters of a thread.
+struct ThreadCounters
+{
+    bool enabled;                            ///< Count the allocations of this thread.
+    Scope scope;                             ///< The current scope.
+    uint64_t num_allocations[num_scopes];    ///< The number of allocations per scope.
+    uint64_t bytes_allocated[num_scopes];    ///< The number of bytes allocated per scope.
+    int64_t live_bytes;                      ///< The bytes allocated minus the bytes freed.
+    int64_t peak_live_bytes;                 ///< The maximum of live_bytes.
+};
+
+/// The counters of the current thread.
+extern thread_local ThreadCounters counters;
+
+/// Set by the allocation hooks if linked into the program.
+extern bool hooks_installed;
+
+/// Records the allocation of the given size.
+inline void on_alloc(size_t size) noexcept
+{
+    auto& c = counters;
+    ++c.num_allocations[c.scope];
+    c.bytes_allocated[c.scope] += size;
+    c.live_bytes += static_cast<int64_t>(size);
+    if (c.live_bytes > c.peak_live_bytes)
+        c.peak_live_bytes = c.live_bytes;
+}
+
+/// Records the deallocation of the given size.
+inline void on_free(size_t size) noexcept
+{
+    counters.live_bytes -= static_cast<int64_t>(size);
+}
+}  // namespace evmc::tooling::alloc_tracking
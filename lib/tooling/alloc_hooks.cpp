@@ -0,0 +1,106 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+// The interposition of the allocation functions for the allocation tracking.
+// This must be linked into the executable (not into a library) so that the hooks take precedence
+// over the C library functions also for the dynamically loaded VMs.
+//
+// Only glibc is supported: the hooks forward to the glibc internal __libc_* entry points.
+// The C++ operator new and delete are not replaced as libstdc++ implements them with malloc().
+// The hooks are disabled in the sanitizer builds which interpose the allocation functions
+// themselves.
+
+#include "alloc.hpp"
+#include <cerrno>
+#include <cstdlib>
+
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer) || \
+    __has_feature(thread_sanitizer)
+#define EVMC_ALLOC_HOOKS_DISABLED 1
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define EVMC_ALLOC_HOOKS_DISABLED 1
+#endif
+
+#if defined(__GLIBC__) && !defined(EVMC_ALLOC_HOOKS_DISABLED)
+#include <malloc.h>
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t num, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace
+{
+using namespace evmc::tooling::alloc_tracking;
+
+inline void* track_alloc(void* ptr) noexcept
+{
+    if (ptr != nullptr && counters.enabled)
+        on_alloc(malloc_usable_size(ptr));
+    return ptr;
+}
+
+inline void track_free(void* ptr) noexcept
+{
+    if (ptr != nullptr && counters.enabled)
+        on_free(malloc_usable_size(ptr));
+}
+
+[[maybe_unused]] const bool installed = (hooks_installed = true);
+}  // namespace
+
+extern "C" {
+void* malloc(size_t size) noexcept
+{
+    return track_alloc(__libc_malloc(size));
+}
+
+void* calloc(size_t num, size_t size) noexcept
+{
+    return track_alloc(__libc_calloc(num, size));
+}
+
+void* realloc(void* ptr, size_t size) noexcept
+{
+    const auto old_size = (ptr != nullptr && counters.enabled) ? malloc_usable_size(ptr) : 0;
+    auto* new_ptr = __libc_realloc(ptr, size);
+    if (new_ptr != nullptr || size == 0)  // The old block has been freed.
+        on_free(old_size);
+    return track_alloc(new_ptr);
+}
+
+void* memalign(size_t alignment, size_t size) noexcept
+{
+    return track_alloc(__libc_memalign(alignment, size));
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    return track_alloc(__libc_memalign(alignment, size));
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) noexcept
+{
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+        return EINVAL;
+    auto* p = track_alloc(__libc_memalign(alignment, size));
+    if (p == nullptr)
+        return ENOMEM;
+    *ptr = p;
+    return 0;
+}
+
+void free(void* ptr) noexcept
+{
+    track_free(ptr);
+    __libc_free(ptr);
+}
+}
+#endif
@@ -0,0 +1,527 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "alloc.hpp"
+#include "json.hpp"
+#include "perf.hpp"
+#include <evmc/tooling.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <ostream>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace evmc::tooling
+{
+namespace
+{
+/// Returns the two-sided 95% critical value of the Student's t-distribution
+/// for the given degrees of freedom.
+double t_critical_95(size_t df) noexcept
+{
+    // Values for df = 1..30. For larger df the normal distribution approximation is used.
+    static constexpr double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+    };
+    if (df == 0)
+        return 0;
+    if (df <= std::size(table))
+        return table[df - 1];
+    return 1.960;
+}
+
+/// Computes the percentile of the sorted samples using the linear interpolation
+/// between the closest ranks.
+double percentile(const std::vector<double>& sorted, double p) noexcept
+{
+    const auto rank = p * static_cast<double>(sorted.size() - 1);
+    const auto lo = static_cast<size_t>(std::floor(rank));
+    const auto hi = std::min(lo + 1, sorted.size() - 1);
+    const auto frac = rank - static_cast<double>(lo);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * frac;
+}
+
+/// Escapes the CSV field (RFC 4180): the field containing a comma, a quotation mark
+/// or a line break is enclosed in quotation marks with the quotation marks doubled.
+std::string csv_escape(std::string_view s)
+{
+    if (s.find_first_of(",\"\r\n") == std::string_view::npos)
+        return std::string{s};
+
+    std::string out{'"'};
+    for (const auto c : s)
+    {
+        if (c == '"')
+            out += '"';
+        out += c;
+    }
+    out += '"';
+    return out;
+}
+
+/// Pins the current thread to the CPU. Returns false if not successful or not supported.
+bool pin_current_thread(int cpu) noexcept
+{
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+        return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<size_t>(cpu), &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+/// The host hooks attributing the allocations in the host callbacks to the host.
+class AllocScopeHooks
+{
+    alloc_tracking::Scope m_prev_scope = alloc_tracking::vm_scope;
+    uint32_t m_depth = 0;
+
+public:
+    void enter(HostMethod /*method*/) noexcept
+    {
+        if (m_depth++ != 0)
+            return;  // Nested callback: already in the host scope.
+
+        m_prev_scope = alloc_tracking::counters.scope;
+        alloc_tracking::counters.scope = alloc_tracking::host_scope;
+    }
+
+    void leave(HostMethod /*method*/) noexcept
+    {
+        if (--m_depth == 0)
+            alloc_tracking::counters.scope = m_prev_scope;
+    }
+};
+
+/// Executes the code the given number of times with the allocation tracking enabled
+/// and returns the allocation statistics per execution.
+AllocStats measure_allocations(Host& host,
+                               VM& vm,
+                               evmc_revision rev,
+                               const evmc_message& msg,
+                               bytes_view code,
+                               const std::function<void()>& reset,
+                               uint64_t num_executions)
+{
+    using namespace alloc_tracking;
+
+    AllocScopeHooks hooks;
+    HookedHost<AllocScopeHooks> hooked_host{host, hooks};
+
+    auto& c = counters;
+    c = {};
+    int64_t peak_live_bytes = 0;
+    for (uint64_t i = 0; i < num_executions; ++i)
+    {
+        // Track the peak of the memory allocated during the execution only.
+        c.live_bytes = 0;
+        c.peak_live_bytes = 0;
+        c.scope = vm_scope;
+        c.enabled = true;
+        vm.execute(hooked_host, rev, msg, code.data(), code.size());  // Includes result release.
+        c.enabled = false;
+        peak_live_bytes = std::max(peak_live_bytes, c.peak_live_bytes);
+
+        // The restoration of the host state is not the part of the execution.
+        if (reset)
+            reset();
+    }
+
+    const auto n = static_cast<double>(num_executions);
+    AllocStats stats;
+    stats.vm.num_allocations = static_cast<double>(c.num_allocations[vm_scope]) / n;
+    stats.vm.bytes_allocated = static_cast<double>(c.bytes_allocated[vm_scope]) / n;
+    stats.host.num_allocations = static_cast<double>(c.num_allocations[host_scope]) / n;
+    stats.host.bytes_allocated = static_cast<double>(c.bytes_allocated[host_scope]) / n;
+    stats.peak_live_bytes = static_cast<uint64_t>(peak_live_bytes);
+    return stats;
+}
+
+/// Executes the code the given number of times with the host callbacks profiled.
+HostProfile profile_host(Host& host,
+                         VM& vm,
+                         evmc_revision rev,
+                         const evmc_message& msg,
+                         bytes_view code,
+                         const std::function<void()>& reset,
+                         uint64_t num_executions)
+{
+    using clock = std::chrono::steady_clock;
+
+    HostProfiler profiler;
+    InstrumentedHost instrumented_host{host, profiler};
+
+    std::chrono::duration<double, std::nano> total_time{};
+    for (uint64_t i = 0; i < num_executions; ++i)
+    {
+        const auto start = clock::now();
+        vm.execute(instrumented_host, rev, msg, code.data(), code.size());
+        total_time += clock::now() - start;
+
+        if (reset)
+            reset();
+    }
+
+    HostProfile profile;
+    profile.methods = profiler.stats();
+    profile.num_executions = num_executions;
+    profile.total_time = total_time.count();
+    return profile;
+}
+
+/// Executes the code concurrently on the given number of threads for the given duration
+/// and returns the results of every thread.
+std::vector<ThreadResult> run_threads(VM& vm,
+                                      evmc_revision rev,
+                                      const evmc_message& msg,
+                                      bytes_view code,
+                                      const FlatMockedHost& state,
+                                      const BenchOptions& options,
+                                      size_t num_threads,
+                                      std::chrono::nanoseconds duration)
+{
+    using clock = std::chrono::steady_clock;
+
+    std::vector<ThreadResult> results(num_threads);
+    std::atomic<size_t> num_ready{0};
+    std::atomic<bool> start{false};
+    std::atomic<bool> stop{false};
+
+    const auto worker = [&](size_t index) {
+        auto& result = results[index];
+        if (!options.cpus.empty())
+        {
+            const auto cpu = options.cpus[index % options.cpus.size()];
+            if (pin_current_thread(cpu))
+                result.cpu = cpu;
+        }
+
+        FlatMockedHost host{state};
+        std::optional<size_t> checkpoint;
+        if (options.isolate_state)
+            checkpoint = host.checkpoint();
+        const auto execute = [&] {
+            vm.execute(host, rev, msg, code.data(), code.size());
+            if (checkpoint)
+                host.revert(*checkpoint);
+        };
+
+        for (int i = 0; i < options.warmup_iterations; ++i)
+            execute();
+
+        // Wait for all the threads to start measuring at the same time.
+        num_ready.fetch_add(1);
+        while (!start.load())
+            std::this_thread::yield();
+
+        const auto start_time = clock::now();
+        uint64_t n = 0;
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            execute();
+            ++n;
+        }
+        const std::chrono::duration<double> elapsed = clock::now() - start_time;
+        result.num_executions = n;
+        result.throughput = static_cast<double>(n) / elapsed.count();
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i)
+        threads.emplace_back(worker, i);
+
+    while (num_ready.load() != num_threads)
+        std::this_thread::yield();
+    start.store(true);
+    std::this_thread::sleep_for(duration);
+    stop.store(true);
+
+    for (auto& t : threads)
+        t.join();
+    return results;
+}
+}  // namespace
+
+BenchStats compute_stats(std::vector<double> samples)
+{
+    assert(!samples.empty());
+    std::sort(samples.begin(), samples.end());
+
+    BenchStats s;
+    const auto n = samples.size();
+    s.num_samples = n;
+    s.min = samples.front();
+    s.max = samples.back();
+    s.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(n);
+    s.median = percentile(samples, 0.5);
+    s.p90 = percentile(samples, 0.9);
+    s.p99 = percentile(samples, 0.99);
+
+    if (n > 1)
+    {
+        double sum_sq = 0;
+        for (const auto x : samples)
+            sum_sq += (x - s.mean) * (x - s.mean);
+        s.stddev = std::sqrt(sum_sq / static_cast<double>(n - 1));
+    }
+
+    const auto margin = t_critical_95(n - 1) * s.stddev / std::sqrt(static_cast<double>(n));
+    s.ci95_low = s.mean - margin;
+    s.ci95_high = s.mean + margin;
+
+    const auto q1 = percentile(samples, 0.25);
+    const auto q3 = percentile(samples, 0.75);
+    const auto iqr = q3 - q1;
+    s.num_outliers = static_cast<size_t>(std::count_if(
+        samples.begin(), samples.end(),
+        [lo = q1 - 1.5 * iqr, hi = q3 + 1.5 * iqr](double x) { return x < lo || x > hi; }));
+    return s;
+}
+
+BenchResult measure(Host& host,
+                    VM& vm,
+                    evmc_revision rev,
+                    const evmc_message& msg,
+                    bytes_view code,
+                    const BenchOptions& options,
+                    const std::function<void()>& reset)
+{
+    using clock = std::chrono::steady_clock;
+    using ns = std::chrono::duration<double, std::nano>;
+
+    const auto execute = [&] {
+        auto r = vm.execute(host, rev, msg, code.data(), code.size());
+        if (reset)
+            reset();
+        return r;
+    };
+
+    BenchResult r;
+    r.vm_name = vm.name();
+    r.vm_version = vm.version();
+    r.rev = rev;
+    r.gas_used = msg.gas - execute().gas_left;
+
+    for (int i = 0; i < options.warmup_iterations; ++i)
+        execute();
+
+    // Executes the batch of n executions and returns the average time of a single one.
+    const auto run_batch = [&](uint64_t n) {
+        const auto start = clock::now();
+        for (uint64_t i = 0; i < n; ++i)
+            execute();
+        return ns{clock::now() - start} / static_cast<double>(n);
+    };
+
+    // Calibrate the batch size: grow it geometrically until the batch time is long enough
+    // to be measured precisely and then scale it to match the target sample time.
+    const auto sample_time = ns{options.sample_time};
+    uint64_t batch_size = 1;
+    while (true)
+    {
+        const auto t = run_batch(batch_size);
+        const auto batch_time = t * static_cast<double>(batch_size);
+        if (batch_time * 8 >= sample_time || batch_size >= (uint64_t{1} << 40))
+        {
+            if (t.count() > 0)
+                batch_size = std::max(uint64_t{1}, static_cast<uint64_t>(sample_time / t));
+            break;
+        }
+        batch_size *= 8;
+    }
+    r.batch_size = batch_size;
+
+    std::optional<PerfEventSet> perf_events;
+    if (options.perf_counters)
+        perf_events.emplace();
+
+    const auto num_samples = static_cast<size_t>(std::max(options.num_samples, 1));
+    r.samples.reserve(num_samples);
+    if (perf_events)
+        perf_events->start();
+    for (size_t i = 0; i < num_samples; ++i)
+        r.samples.push_back(run_batch(batch_size).count());
+    if (perf_events)
+    {
+        perf_events->stop();
+        r.perf = perf_events->read(batch_size * num_samples);
+    }
+    r.stats = compute_stats(r.samples);
+
+    if (options.profile_host)
+        r.host_profile = profile_host(host, vm, rev, msg, code, reset, batch_size);
+
+    if (options.track_allocations && alloc_tracking_available())
+        r.allocs = measure_allocations(host, vm, rev, msg, code, reset, batch_size);
+    return r;
+}
+
+ScalingResult measure_scaling(VM& vm,
+                              evmc_revision rev,
+                              const evmc_message& msg,
+                              bytes_view code,
+                              const FlatMockedHost& state,
+                              const BenchOptions& options)
+{
+    const auto duration = options.sample_time * std::max(options.num_samples, 1);
+
+    ScalingResult r;
+    {
+        FlatMockedHost host{state};
+        r.gas_used = msg.gas - vm.execute(host, rev, msg, code.data(), code.size()).gas_left;
+    }
+    r.single_thread_throughput =
+        run_threads(vm, rev, msg, code, state, options, 1, duration).front().throughput;
+    r.threads = run_threads(vm, rev, msg, code, state, options,
+                            static_cast<size_t>(std::max(options.num_threads, 1)), duration);
+    return r;
+}
+
+void write_report(std::ostream& out, ReportFormat format, const BenchResult& result)
+{
+    // Format into a local stream to not modify the formatting flags of the output stream.
+    std::ostringstream o;
+    o.precision(10);
+    const auto& s = result.stats;
+
+    switch (format)
+    {
+    case ReportFormat::json:
+    {
+        o << "{\n"
+          << "  \"vm\": \"" << json::escape(result.vm_name) << "\",\n"
+          << "  \"vm_version\": \"" << json::escape(result.vm_version) << "\",\n"
+          << "  \"revision\": \"" << result.rev << "\",\n"
+          << "  \"gas_used\": " << result.gas_used << ",\n"
+          << "  \"batch_size\": " << result.batch_size << ",\n"
+          << "  \"num_samples\": " << s.num_samples << ",\n"
+          << "  \"time_ns\": {\"min\": " << s.min << ", \"max\": " << s.max
+          << ", \"mean\": " << s.mean << ", \"median\": " << s.median << ", \"p90\": " << s.p90
+          << ", \"p99\": " << s.p99 << ", \"stddev\": " << s.stddev << ", \"ci95\": ["
+          << s.ci95_low << ", " << s.ci95_high << "]},\n"
+          << "  \"num_outliers\": " << s.num_outliers << ",\n"
+          << "  \"mgas_per_s\": " << result.gas_rate() << ",\n";
+        if (result.perf)
+        {
+            // The counters not available are null.
+            o << "  \"perf\": {";
+            for (size_t i = 0; i < num_perf_events; ++i)
+            {
+                o << (i == 0 ? "" : ", ") << '"' << to_string(static_cast<PerfEvent>(i)) << "\": ";
+                if (const auto& v = result.perf->values[i]; v)
+                    o << *v;
+                else
+                    o << "null";
+            }
+            o << ", \"ipc\": ";
+            if (const auto ipc = result.perf->ipc(); ipc)
+                o << *ipc;
+            else
+                o << "null";
+            o << "},\n";
+        }
+        if (result.host_profile)
+        {
+            const auto& p = *result.host_profile;
+            const auto n = static_cast<double>(p.num_executions);
+            o << "  \"host\": {\"fraction\": " << p.host_fraction()
+              << ", \"calls_per_execution\": " << p.calls_per_execution() << ", \"methods\": {";
+            auto first = true;
+            for (size_t i = 0; i < num_host_methods; ++i)
+            {
+                const auto& m = p.methods[i];
+                if (m.num_calls == 0)
+                    continue;
+                o << (first ? "" : ", ") << '"' << to_string(static_cast<HostMethod>(i))
+                  << "\": {\"calls_per_execution\": " << static_cast<double>(m.num_calls) / n
+                  << ", \"mean_latency_ns\": " << m.mean_latency() << "}";
+                first = false;
+            }
+            o << "}},\n";
+        }
+        if (result.allocs)
+        {
+            const auto& a = *result.allocs;
+            o << "  \"allocs\": {\"vm\": {\"num_allocations\": " << a.vm.num_allocations
+              << ", \"bytes_allocated\": " << a.vm.bytes_allocated
+              << "}, \"host\": {\"num_allocations\": " << a.host.num_allocations
+              << ", \"bytes_allocated\": " << a.host.bytes_allocated
+              << "}, \"peak_live_bytes\": " << a.peak_live_bytes << "},\n";
+        }
+        o << "  \"samples_ns\": [";
+        for (size_t i = 0; i < result.samples.size(); ++i)
+            o << (i == 0 ? "" : ", ") << result.samples[i];
+        o << "]\n}\n";
+        break;
+    }
+    case ReportFormat::csv:
+        o << "vm,vm_version,revision,gas_used,batch_size,num_samples,min_ns,max_ns,mean_ns,"
+             "median_ns,p90_ns,p99_ns,stddev_ns,ci95_low_ns,ci95_high_ns,num_outliers,"
+             "mgas_per_s";
+        if (result.perf)
+        {
+            for (size_t i = 0; i < num_perf_events; ++i)
+                o << ',' << to_string(static_cast<PerfEvent>(i));
+            o << ",ipc";
+        }
+        if (result.host_profile)
+            o << ",host_fraction,host_calls";
+        if (result.allocs)
+            o << ",vm_allocations,vm_bytes_allocated,host_allocations,host_bytes_allocated,"
+                 "peak_live_bytes";
+        o << '\n'
+          << csv_escape(result.vm_name) << ',' << csv_escape(result.vm_version) << ','
+          << result.rev << ',' << result.gas_used << ',' << result.batch_size << ','
+          << s.num_samples << ',' << s.min << ',' << s.max << ',' << s.mean << ',' << s.median
+          << ',' << s.p90 << ',' << s.p99 << ',' << s.stddev << ',' << s.ci95_low << ','
+          << s.ci95_high << ',' << s.num_outliers << ',' << result.gas_rate();
+        if (result.perf)
+        {
+            // The counters not available are empty.
+            for (const auto& v : result.perf->values)
+            {
+                o << ',';
+                if (v)
+                    o << *v;
+            }
+            o << ',';
+            if (const auto ipc = result.perf->ipc(); ipc)
+                o << *ipc;
+        }
+        if (result.host_profile)
+        {
+            o << ',' << result.host_profile->host_fraction() << ','
+              << result.host_profile->calls_per_execution();
+        }
+        if (result.allocs)
+        {
+            const auto& a = *result.allocs;
+            o << ',' << a.vm.num_allocations << ',' << a.vm.bytes_allocated << ','
+              << a.host.num_allocations << ',' << a.host.bytes_allocated << ','
+              << a.peak_live_bytes;
+        }
+        o << '\n';
+        break;
+    }
+
+    out << o.str();
+}
+}  // namespace evmc::tooling
@@ -0,0 +1,246 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <evmc/instructions.h>
+#include <evmc/tooling.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace evmc::tooling
+{
+namespace
+{
+/// The additional cost of the first access to a storage slot (EIP-2929).
+constexpr int64_t cold_sload_extra_cost = 2100 - 100;
+
+/// The additional cost of the first access to an account (EIP-2929).
+constexpr int64_t cold_account_access_extra_cost = 2600 - 100;
+
+/// The cost of the SSTORE changing a zero slot (not modified in the transaction) to non-zero.
+constexpr int64_t sstore_set_cost = 20000;
+
+/// The cost of the SSTORE of a slot already modified in the transaction.
+constexpr int64_t sstore_dirty_cost = 100;
+
+/// The address of the account called by the call program.
+constexpr auto callee_address = 0x00000000000000000000000000000000000ca11e_address;
+
+int64_t num_words(uint64_t size) noexcept
+{
+    return static_cast<int64_t>((size + 31) / 32);
+}
+
+/// The total cost of the memory of the given number of words.
+int64_t memory_cost(int64_t words) noexcept
+{
+    return 3 * words + words * words / 512;
+}
+
+/// The EVM bytecode builder accounting the gas cost of the execution.
+///
+/// The static costs of the instructions come from the instruction metrics table
+/// of the revision. The dynamic costs are added explicitly by the program generators.
+class Program
+{
+    const evmc_instruction_metrics* m_metrics;
+    bytes m_code;
+    int64_t m_gas = 0;
+
+public:
+    explicit Program(evmc_revision rev) noexcept
+      : m_metrics{evmc_get_instruction_metrics_table(rev)}
+    {}
+
+    /// Appends the instruction.
+    Program& op(evmc_opcode opcode)
+    {
+        m_code.push_back(static_cast<uint8_t>(opcode));
+        m_gas += m_metrics[opcode].gas_cost;
+        return *this;
+    }
+
+    /// Appends the shortest PUSH instruction of the value (PUSH1 for zero).
+    Program& push(uint64_t value)
+    {
+        int n = 1;
+        while (n < 8 && (value >> (8 * n)) != 0)
+            ++n;
+        op(static_cast<evmc_opcode>(OP_PUSH1 + n - 1));
+        for (int i = n - 1; i >= 0; --i)
+            m_code.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        return *this;
+    }
+
+    /// Appends the PUSH20 instruction of the address.
+    Program& push(const address& addr)
+    {
+        op(OP_PUSH20);
+        m_code.append(addr.bytes, sizeof(addr.bytes));
+        return *this;
+    }
+
+    /// Appends the loop executing the body the given number of times (at least once).
+    ///
+    /// The loop counter is kept on the top of the stack, starting from @p iterations
+    /// down to 1. The body must not change the stack height.
+    template <typename Body>
+    Program& loop(uint32_t iterations, Body body)
+    {
+        push(iterations);
+        const auto gas_before = m_gas;
+        const auto loop_begin = m_code.size();
+        op(OP_JUMPDEST);
+        body(*this);
+        push(1).op(OP_SWAP1).op(OP_SUB).op(OP_DUP1).push(loop_begin).op(OP_JUMPI);
+        m_gas = gas_before + (m_gas - gas_before) * iterations;
+        return *this;
+    }
+
+    /// Adds the dynamic gas cost.
+    Program& gas(int64_t cost) noexcept
+    {
+        m_gas += cost;
+        return *this;
+    }
+
+    BenchCase build(std::string name) const { return {std::move(name), m_code, {}, m_gas}; }
+};
+
+/// The arithmetic loop: the repeated squaring and addition.
+Program arith(evmc_revision rev, uint32_t n, uint32_t /*size*/)
+{
+    Program p{rev};
+    p.push(1).loop(n, [](Program& b) {
+        b.op(OP_SWAP1).op(OP_DUP1).op(OP_MUL).push(3).op(OP_ADD).op(OP_SWAP1);
+    });
+    return p.op(OP_STOP);
+}
+
+/// The MLOAD and MSTORE loop over the memory region of the size, expanding the memory.
+Program memory(evmc_revision rev, uint32_t n, uint32_t size)
+{
+    const auto region_words = std::max(num_words(size), int64_t{1});
+    Program p{rev};
+    // offset = (counter * 32) % region_size; mstore(offset, mload(offset))
+    p.loop(n, [region_words](Program& b) {
+        b.op(OP_DUP1).push(5).op(OP_SHL).push(static_cast<uint64_t>(region_words * 32));
+        b.op(OP_SWAP1).op(OP_MOD).op(OP_DUP1).op(OP_MLOAD).op(OP_SWAP1).op(OP_MSTORE);
+    });
+    // The highest touched word is counter % region_words for counter in [1, n].
+    return p.gas(memory_cost(std::min(int64_t{n}, region_words - 1) + 1)).op(OP_STOP);
+}
+
+/// The KECCAK256 loop hashing the memory of the size.
+Program keccak256(evmc_revision rev, uint32_t n, uint32_t size)
+{
+    Program p{rev};
+    p.loop(n, [size](Program& b) { b.push(size).push(0).op(OP_KECCAK256).op(OP_POP); });
+    return p.gas(memory_cost(num_words(size)) + 6 * num_words(size) * n).op(OP_STOP);
+}
+
+/// The SLOAD and SSTORE loop incrementing the same (hot) storage slot.
+Program storage_hot(evmc_revision rev, uint32_t n, uint32_t /*size*/)
+{
+    Program p{rev};
+    p.loop(n, [](Program& b) {
+        b.push(0).op(OP_SLOAD).push(1).op(OP_ADD).push(0).op(OP_SSTORE);
+    });
+    return p.gas(cold_sload_extra_cost + sstore_set_cost + sstore_dirty_cost * (n - 1))
+        .op(OP_STOP);
+}
+
+/// The SLOAD and SSTORE loop setting a different (cold) storage slot every iteration.
+Program storage_cold(evmc_revision rev, uint32_t n, uint32_t /*size*/)
+{
+    Program p{rev};
+    // sstore(counter, add(sload(counter), 1))
+    p.loop(n, [](Program& b) {
+        b.op(OP_DUP1).op(OP_SLOAD).push(1).op(OP_ADD).op(OP_DUP2).op(OP_SSTORE);
+    });
+    return p.gas((cold_sload_extra_cost + sstore_set_cost) * n).op(OP_STOP);
+}
+
+/// The CALL loop calling the same account without value and gas.
+Program calls(evmc_revision rev, uint32_t n, uint32_t /*size*/)
+{
+    Program p{rev};
+    // call(0, callee, 0, 0, 0, 0, 0)
+    p.loop(n, [](Program& b) {
+        b.push(0).push(0).push(0).push(0).push(0).push(callee_address).push(0);
+        b.op(OP_CALL).op(OP_POP);
+    });
+    return p.gas(cold_account_access_extra_cost).op(OP_STOP);
+}
+
+/// The LOG2 loop logging the memory of the size.
+Program logs(evmc_revision rev, uint32_t n, uint32_t size)
+{
+    Program p{rev};
+    p.loop(n, [size](Program& b) { b.push(2).push(1).push(size).push(0).op(OP_LOG2); });
+    return p.gas(memory_cost(num_words(size)) + 8 * int64_t{size} * n).op(OP_STOP);
+}
+
+/// Returns the memory of the size.
+Program return_data(evmc_revision rev, uint32_t /*n*/, uint32_t size)
+{
+    Program p{rev};
+    return p.push(size).push(0).op(OP_RETURN).gas(memory_cost(num_words(size)));
+}
+
+/// The program generator: the name, the generator function and whether it contains the loop.
+struct Generator
+{
+    const char* name;
+    Program (*generate)(evmc_revision rev, uint32_t n, uint32_t size);
+    bool has_loop;
+};
+
+constexpr Generator generators[] = {
+    {"arith", arith, true},
+    {"call", calls, true},
+    {"keccak256", keccak256, true},
+    {"log2", logs, true},
+    {"memory", memory, true},
+    {"return_data", return_data, false},
+    {"storage_cold", storage_cold, true},
+    {"storage_hot", storage_hot, true},
+};
+}  // namespace
+
+std::vector<BenchCase> generate_bench_corpus(const BenchGenOptions& options)
+{
+    if (options.rev < EVMC_BERLIN)
+        throw std::invalid_argument{"the gas costs are only supported since Berlin"};
+    if (options.max_iterations == 0)
+        throw std::invalid_argument{"the number of iterations must be positive"};
+
+    std::vector<BenchCase> cases;
+    for (const auto& g : generators)
+    {
+        const auto gas_of = [&](uint32_t n) {
+            return g.generate(options.rev, n, options.size).build(g.name).expected_gas.value();
+        };
+
+        if (gas_of(1) > options.gas_limit)
+            throw std::invalid_argument{std::string{"gas limit too low for "} + g.name};
+
+        // Find the maximum number of iterations fitting into the gas limit.
+        uint32_t n = 1;
+        if (g.has_loop)
+        {
+            uint32_t hi = options.max_iterations;
+            while (n < hi)
+            {
+                const auto mid = n + (hi - n + 1) / 2;
+                if (gas_of(mid) <= options.gas_limit)
+                    n = mid;
+                else
+                    hi = mid - 1;
+            }
+        }
+        cases.push_back(g.generate(options.rev, n, options.size).build(g.name));
+    }
+    return cases;
+}
+}  // namespace evmc::tooling
@@ -0,0 +1,282 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "json.hpp"
+#include <evmc/hex.hpp>
+#include <evmc/mocked_host.hpp>
+#include <evmc/tooling.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <system_error>
+
+namespace evmc::tooling
+{
+namespace
+{
+constexpr auto code_suffix = ".hex";
+constexpr auto input_suffix = ".input.hex";
+constexpr auto gas_suffix = ".gas";
+
+bool ends_with(std::string_view s, std::string_view suffix) noexcept
+{
+    return s.size() >= suffix.size() && s.substr(s.size() - suffix.size()) == suffix;
+}
+
+int64_t load_gas_file(const std::filesystem::path& path)
+{
+    std::ifstream file{path};
+    int64_t gas = 0;
+    if (!(file >> gas) || gas < 0 || !(file >> std::ws).eof())
+        throw std::invalid_argument{"invalid gas in " + path.string()};
+    return gas;
+}
+
+void write_file(const std::filesystem::path& path, const std::string& contents)
+{
+    std::ofstream file{path, std::ios::binary};
+    if (!file.write(contents.data(), static_cast<std::streamsize>(contents.size())))
+        throw std::system_error{errno, std::system_category(), path.string()};
+}
+
+/// The result of a corpus case benchmark on a VM.
+struct CaseResult
+{
+    const BenchCase* bench_case = nullptr;  ///< The benchmark case.
+    size_t vm_index = 0;                    ///< The index of the VM.
+    evmc_status_code status = {};           ///< The execution status.
+    int64_t gas_used = 0;                   ///< The gas used by the execution.
+    BenchResult bench;                      ///< The benchmark result.
+    std::vector<std::string> diffs;         ///< The differences from the execution on VM [1].
+};
+
+/// Loads the baseline results as the map (vm, case) => median time.
+std::map<std::pair<std::string, std::string>, double> load_baseline(std::istream& in)
+{
+    const std::string text{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    const auto doc = json::parse(text);
+
+    std::map<std::pair<std::string, std::string>, double> baseline;
+    const auto* results = doc.find("results");
+    if (results == nullptr || results->get<json::Array>() == nullptr)
+        throw std::invalid_argument{"invalid baseline: missing \"results\" array"};
+    for (const auto& entry : *results->get<json::Array>())
+    {
+        const auto* vm = entry.find("vm");
+        const auto* name = entry.find("case");
+        const auto* median = entry.find("median_ns");
+        if (vm == nullptr || vm->get<std::string>() == nullptr || name == nullptr ||
+            name->get<std::string>() == nullptr || median == nullptr ||
+            median->get<double>() == nullptr)
+            throw std::invalid_argument{"invalid baseline: invalid result entry"};
+        baseline[{*vm->get<std::string>(), *name->get<std::string>()}] = *median->get<double>();
+    }
+    return baseline;
+}
+
+void write_results(std::ostream& out,
+                   const std::vector<std::pair<std::string, VM>>& vms,
+                   evmc_revision rev,
+                   int64_t gas,
+                   const std::vector<CaseResult>& results)
+{
+    std::ostringstream o;
+    o.precision(10);
+    o << "{\n  \"revision\": \"" << rev << "\",\n  \"gas_limit\": " << gas
+      << ",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& r = results[i];
+        const auto& s = r.bench.stats;
+        o << "    {\"vm\": \"" << json::escape(vms[r.vm_index].first) << "\", \"case\": \""
+          << json::escape(r.bench_case->name) << "\", \"status\": \"" << r.status
+          << "\", \"gas_used\": " << r.bench.gas_used << ", \"median_ns\": " << s.median
+          << ", \"mean_ns\": " << s.mean << ", \"stddev_ns\": " << s.stddev
+          << ", \"mgas_per_s\": " << r.bench.gas_rate() << "}"
+          << (i + 1 != results.size() ? "," : "") << "\n";
+    }
+    o << "  ]\n}\n";
+    out << o.str();
+}
+}  // namespace
+
+std::vector<BenchCase> load_corpus(const std::string& dir)
+{
+    std::vector<BenchCase> cases;
+    for (const auto& entry : std::filesystem::directory_iterator{dir})
+    {
+        if (!entry.is_regular_file())
+            continue;
+        const auto filename = entry.path().filename().string();
+        if (!ends_with(filename, code_suffix) || ends_with(filename, input_suffix))
+            continue;
+
+        BenchCase c;
+        c.name = filename.substr(0, filename.size() - std::string_view{code_suffix}.size());
+        c.code = load_hex_file(entry.path().string());
+        const auto input_path = entry.path().parent_path() / (c.name + input_suffix);
+        if (std::filesystem::exists(input_path))
+            c.input = load_hex_file(input_path.string());
+        const auto gas_path = entry.path().parent_path() / (c.name + gas_suffix);
+        if (std::filesystem::exists(gas_path))
+            c.expected_gas = load_gas_file(gas_path);
+        cases.emplace_back(std::move(c));
+    }
+    std::sort(cases.begin(), cases.end(),
+              [](const BenchCase& a, const BenchCase& b) { return a.name < b.name; });
+    return cases;
+}
+
+void save_corpus(const std::string& dir, const std::vector<BenchCase>& cases)
+{
+    const std::filesystem::path path{dir};
+    std::filesystem::create_directories(path);
+    for (const auto& c : cases)
+    {
+        write_file(path / (c.name + code_suffix), hex(c.code) + "\n");
+        if (!c.input.empty())
+            write_file(path / (c.name + input_suffix), hex(c.input) + "\n");
+        if (c.expected_gas)
+            write_file(path / (c.name + gas_suffix), std::to_string(*c.expected_gas) + "\n");
+    }
+}
+
+int bench_corpus(std::vector<std::pair<std::string, VM>>& vms,
+                 const std::vector<BenchCase>& cases,
+                 evmc_revision rev,
+                 int64_t gas,
+                 const CorpusBenchOptions& options,
+                 std::ostream& out)
+{
+    std::map<std::pair<std::string, std::string>, double> baseline;
+    if (options.baseline != nullptr)
+        baseline = load_baseline(*options.baseline);
+
+    out << "Benchmarking " << cases.size() << " cases on " << vms.size() << " VMs (" << rev
+        << ", " << gas << " gas limit)\n";
+    for (size_t i = 0; i < vms.size(); ++i)
+        out << "  [" << (i + 1) << "] " << vms[i].first << "\n";
+    out << "\n";
+
+    std::vector<CaseResult> results;
+    results.reserve(cases.size() * vms.size());
+    for (const auto& c : cases)
+    {
+        for (size_t i = 0; i < vms.size(); ++i)
+        {
+            auto& vm = vms[i].second;
+            FlatMockedHost host;
+            evmc_message msg{};
+            msg.gas = gas;
+            msg.input_data = c.input.data();
+            msg.input_size = c.input.size();
+
+            const auto checkpoint = host.checkpoint();
+            const auto result = vm.execute(host, rev, msg, c.code.data(), c.code.size());
+            host.revert(checkpoint);
+
+            const auto reset = [&host, checkpoint] { host.revert(checkpoint); };
+            results.push_back({&c, i, result.status_code, gas - result.gas_left,
+                               measure(host, vm, rev, msg, c.code, options.bench, reset), {}});
+            if (options.diff && i != 0)
+                results.back().diffs =
+                    diff_executions(vms[0].second, vm, rev, msg, c.code, FlatMockedHost{});
+        }
+    }
+
+    // Format into a local stream to not modify the formatting flags of the output stream.
+    constexpr int name_width = 24;
+    constexpr int value_width = 14;
+    std::ostringstream o;
+    o << std::fixed << std::setprecision(1) << std::left << std::setw(name_width) << "case"
+      << std::right;
+    for (size_t i = 0; i < vms.size(); ++i)
+    {
+        const auto label = "[" + std::to_string(i + 1) + "] ";
+        o << std::setw(value_width) << label + "ns/exec" << std::setw(value_width)
+          << label + "Mgas/s";
+    }
+    o << "\n";
+
+    for (size_t k = 0; k < results.size(); k += vms.size())
+    {
+        o << std::left << std::setw(name_width) << results[k].bench_case->name << std::right;
+        for (size_t i = 0; i < vms.size(); ++i)
+        {
+            const auto& r = results[k + i];
+            o << std::setw(value_width) << r.bench.stats.median << std::setw(value_width)
+              << std::setprecision(3) << r.bench.gas_rate() << std::setprecision(1);
+        }
+        o << "\n";
+    }
+
+    for (const auto& r : results)
+    {
+        if (r.status != EVMC_SUCCESS)
+        {
+            o << "WARNING! " << r.bench_case->name << " [" << (r.vm_index + 1)
+              << "]: execution status " << r.status << "\n";
+        }
+        else if (r.bench_case->expected_gas && r.gas_used != *r.bench_case->expected_gas)
+        {
+            o << "WARNING! " << r.bench_case->name << " [" << (r.vm_index + 1)
+              << "]: gas used " << r.gas_used << ", expected " << *r.bench_case->expected_gas
+              << "\n";
+        }
+    }
+
+    int num_mismatches = 0;
+    if (options.diff)
+    {
+        o << "\nDifferential check against [1]:\n";
+        for (size_t k = 0; k < results.size(); k += vms.size())
+        {
+            for (size_t i = 1; i < vms.size(); ++i)
+            {
+                const auto& r = results[k + i];
+                num_mismatches += !r.diffs.empty();
+                o << "  " << r.bench_case->name << " [" << (i + 1) << "]: "
+                  << (r.diffs.empty() ? "identical" : "MISMATCH") << ", "
+                  << std::setprecision(3) << r.bench.stats.median / results[k].bench.stats.median
+                  << std::setprecision(1) << "x time\n";
+                for (const auto& d : r.diffs)
+                    o << "      " << d << "\n";
+            }
+        }
+        o << num_mismatches << " mismatches\n";
+    }
+
+    int num_regressions = 0;
+    if (options.baseline != nullptr)
+    {
+        o << "\nBaseline comparison (threshold " << options.threshold * 100 << "%):\n";
+        for (const auto& r : results)
+        {
+            const auto it = baseline.find({vms[r.vm_index].first, r.bench_case->name});
+            if (it == baseline.end())
+                continue;
+            const auto change = r.bench.stats.median / it->second - 1;
+            const auto regression = change > options.threshold;
+            num_regressions += regression;
+            o << "  " << r.bench_case->name << " [" << (r.vm_index + 1)
+              << "]: " << r.bench.stats.median << " ns vs " << it->second << " ns ("
+              << std::showpos << change * 100 << std::noshowpos << "%)"
+              << (regression ? " REGRESSION" : "") << "\n";
+        }
+        o << num_regressions << " regressions\n";
+    }
+    out << o.str();
+
+    if (options.results != nullptr)
+        write_results(*options.results, vms, rev, gas, results);
+
+    return num_regressions != 0 || num_mismatches != 0 ? 1 : 0;
+}
+}  // namespace evmc::tooling
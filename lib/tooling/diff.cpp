@@ -0,0 +1,184 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <evmc/hex.hpp>
+#include <evmc/mocked_host.hpp>
+#include <evmc/tooling.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace evmc::tooling
+{
+namespace
+{
+std::string hex(const address& addr)
+{
+    return "0x" + evmc::hex({addr.bytes, sizeof(addr.bytes)});
+}
+
+std::string hex(const bytes32& v)
+{
+    return "0x" + evmc::hex({v.bytes, sizeof(v.bytes)});
+}
+
+/// Compares the values, adding the difference description if not equal.
+template <typename T>
+void compare(std::vector<std::string>& diffs, const std::string& name, const T& a, const T& b)
+{
+    if (a == b)
+        return;
+    std::ostringstream s;
+    s << name << ": " << a << " vs " << b;
+    diffs.push_back(s.str());
+}
+
+void compare_storage(std::vector<std::string>& diffs,
+                     const FlatMockedHost& a,
+                     const FlatMockedHost& b)
+{
+    std::set<address> addresses;
+    for (const auto* host : {&a, &b})
+        for (const auto& [addr, _] : host->accounts)
+            addresses.insert(addr);
+
+    const auto storage_of = [](const FlatMockedHost& host, const address& addr) {
+        const auto it = host.accounts.find(addr);
+        return it != host.accounts.end() ? &it->second.storage : nullptr;
+    };
+
+    for (const auto& addr : addresses)
+    {
+        const auto* sa = storage_of(a, addr);
+        const auto* sb = storage_of(b, addr);
+        std::set<bytes32> keys;
+        for (const auto* s : {sa, sb})
+            if (s != nullptr)
+                for (const auto& [key, _] : *s)
+                    keys.insert(key);
+
+        // The missing storage slot is the same as the slot set to zero.
+        const auto value_of = [](const auto* storage, const bytes32& key) {
+            if (storage == nullptr)
+                return bytes32{};
+            const auto it = storage->find(key);
+            return it != storage->end() ? it->second.current : bytes32{};
+        };
+
+        for (const auto& key : keys)
+        {
+            compare(diffs, "storage " + hex(addr) + "[" + hex(key) + "]",
+                    hex(value_of(sa, key)), hex(value_of(sb, key)));
+        }
+    }
+}
+
+void compare_logs(std::vector<std::string>& diffs,
+                  const FlatMockedHost& a,
+                  const FlatMockedHost& b)
+{
+    const auto& la = a.recorded_logs;
+    const auto& lb = b.recorded_logs;
+    compare(diffs, "logs", la.size(), lb.size());
+    for (size_t i = 0; i < std::min(la.size(), lb.size()); ++i)
+    {
+        const auto name = "log " + std::to_string(i);
+        compare(diffs, name + " creator", hex(la[i].creator), hex(lb[i].creator));
+        compare(diffs, name + " data", evmc::hex(la[i].data), evmc::hex(lb[i].data));
+        compare(diffs, name + " topics", la[i].topics.size(), lb[i].topics.size());
+        for (size_t k = 0; k < std::min(la[i].topics.size(), lb[i].topics.size()); ++k)
+        {
+            compare(diffs, name + " topic " + std::to_string(k), hex(la[i].topics[k]),
+                    hex(lb[i].topics[k]));
+        }
+    }
+}
+}  // namespace
+
+std::vector<std::string> diff_executions(VM& vm1,
+                                         VM& vm2,
+                                         evmc_revision rev,
+                                         const evmc_message& msg,
+                                         bytes_view code,
+                                         const FlatMockedHost& state)
+{
+    FlatMockedHost host1{state};
+    FlatMockedHost host2{state};
+    const auto r1 = vm1.execute(host1, rev, msg, code.data(), code.size());
+    const auto r2 = vm2.execute(host2, rev, msg, code.data(), code.size());
+
+    std::vector<std::string> diffs;
+    compare(diffs, "status", r1.status_code, r2.status_code);
+    compare(diffs, "gas_left", r1.gas_left, r2.gas_left);
+    compare(diffs, "gas_refund", r1.gas_refund, r2.gas_refund);
+    compare(diffs, "output", evmc::hex({r1.output_data, r1.output_size}),
+            evmc::hex({r2.output_data, r2.output_size}));
+    compare_storage(diffs, host1, host2);
+    compare_logs(diffs, host1, host2);
+    return diffs;
+}
+
+int run_diff(VM& vm1,
+             VM& vm2,
+             evmc_revision rev,
+             int64_t gas,
+             bytes_view code,
+             bytes_view input,
+             const RunOptions& options,
+             std::ostream& out)
+{
+    if (options.create || options.record != nullptr || options.replay != nullptr)
+        throw std::invalid_argument{
+            "comparing VMs does not support contract creation and host recording"};
+
+    out << "Comparing on " << rev << " with " << gas << " gas limit\n\n";
+
+    FlatMockedHost state;
+    if (options.state != nullptr)
+        state.accounts = std::move(*options.state);
+
+    evmc_message msg{};
+    msg.gas = gas;
+    msg.input_data = input.data();
+    msg.input_size = input.size();
+
+    const auto diffs = diff_executions(vm1, vm2, rev, msg, code, state);
+
+    // Measure both VMs from the same initial state.
+    const auto bench_options = options.bench.value_or(BenchOptions{});
+    const auto checkpoint = state.checkpoint();
+    const auto reset = [&state, checkpoint] { state.revert(checkpoint); };
+    const auto r1 = measure(state, vm1, rev, msg, code, bench_options, reset);
+    const auto r2 = measure(state, vm2, rev, msg, code, bench_options, reset);
+
+    std::ostringstream o;
+    o << "Time:     [1] " << std::llround(r1.stats.median) << " ns, [2] "
+      << std::llround(r2.stats.median) << " ns (median of " << r1.stats.num_samples
+      << " samples)\n"
+      << "Ratio:    " << std::fixed << std::setprecision(3)
+      << r2.stats.median / r1.stats.median << " ([2] / [1] time)\n";
+
+    const auto result = vm1.execute(state, rev, msg, code.data(), code.size());
+    state.revert(checkpoint);
+    o << "Result:   " << result.status_code << "\nGas used: " << (msg.gas - result.gas_left)
+      << "\n";
+    if (result.status_code == EVMC_SUCCESS || result.status_code == EVMC_REVERT)
+        o << "Output:   " << evmc::hex({result.output_data, result.output_size}) << "\n";
+
+    if (diffs.empty())
+        o << "Diff:     identical\n";
+    else
+    {
+        o << "Diff:     " << diffs.size() << " differences ([1] vs [2])\n";
+        for (const auto& d : diffs)
+            o << "          " << d << "\n";
+    }
+    out << o.str();
+    return diffs.empty() ? 0 : 1;
+}
+}  // namespace evmc::tooling
@@ -0,0 +1,189 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <evmc/hex.hpp>
+#include <evmc/tooling.hpp>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define EVMC_TOOLING_MMAP 1
+#endif
+
+namespace evmc::tooling
+{
+namespace
+{
+/// The value marking the non-hex characters in the hex_digits table.
+constexpr uint8_t invalid_digit = 0xff;
+
+/// The table of the hex digit values indexed by the character.
+constexpr auto hex_digits = [] {
+    std::array<uint8_t, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i)
+    {
+        const auto v = evmc::internal::from_hex_digit(static_cast<char>(i));
+        table[i] = v < 0 ? invalid_digit : static_cast<uint8_t>(v);
+    }
+    return table;
+}();
+
+inline uint8_t hex_digit(char c) noexcept
+{
+    return hex_digits[static_cast<uint8_t>(c)];
+}
+
+[[noreturn]] void throw_system_error(const std::string& path)
+{
+    throw std::system_error{errno, std::system_category(), path};
+}
+
+/// Decodes the hex string ignoring the whitespace (the same as from_spaced_hex()).
+///
+/// The blocks of hex digits are decoded without the per-character whitespace checks.
+/// The character-by-character decoding is only used for the blocks containing whitespace.
+std::optional<bytes> decode_spaced_hex(std::string_view hex)
+{
+    constexpr size_t block_size = 16;
+
+    const auto end = hex.size();
+    size_t i = 0;
+
+    // Omit the optional 0x prefix (after the leading whitespace).
+    while (i != end && std::isspace(static_cast<unsigned char>(hex[i])))
+        ++i;
+    if (end - i >= 2 && hex[i] == '0' && hex[i + 1] == 'x')
+        i += 2;
+
+    // Returns the value of the next hex digit, skipping the whitespace,
+    // or -1 for invalid character or the end of the input.
+    const auto next_digit = [&]() noexcept -> int {
+        while (i != end && std::isspace(static_cast<unsigned char>(hex[i])))
+            ++i;
+        if (i == end)
+            return -1;
+        const auto v = hex_digit(hex[i++]);
+        return v != invalid_digit ? v : -1;
+    };
+
+    bytes out(hex.size() / 2, 0);
+    auto* o = out.data();
+    while (i != end)
+    {
+        if (end - i >= block_size)
+        {
+            std::array<uint8_t, block_size> v;  // NOLINT(cppcoreguidelines-pro-type-member-init)
+            uint8_t invalid = 0;
+            for (size_t k = 0; k < block_size; ++k)
+            {
+                v[k] = hex_digit(hex[i + k]);
+                invalid |= v[k];
+            }
+            if ((invalid & 0xf0) == 0)
+            {
+                for (size_t k = 0; k < block_size; k += 2)
+                    *o++ = static_cast<uint8_t>((v[k] << 4) | v[k + 1]);
+                i += block_size;
+                continue;
+            }
+        }
+
+        // Slow path: decode a single byte skipping the whitespace.
+        while (i != end && std::isspace(static_cast<unsigned char>(hex[i])))
+            ++i;
+        if (i == end)
+            break;
+        const auto hi = next_digit();
+        const auto lo = next_digit();
+        if (hi < 0 || lo < 0)
+            return {};
+        *o++ = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    out.resize(static_cast<size_t>(o - out.data()));
+    return out;
+}
+}  // namespace
+
+#ifdef EVMC_TOOLING_MMAP
+MappedFile::MappedFile(const std::string& path)
+{
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw_system_error(path);
+
+    struct stat st
+    {
+    };
+    if (::fstat(fd, &st) != 0)
+    {
+        const auto err = errno;
+        ::close(fd);
+        errno = err;
+        throw_system_error(path);
+    }
+
+    m_size = static_cast<size_t>(st.st_size);
+    if (m_size != 0)  // Empty files cannot be mapped.
+    {
+        auto* const p = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED)
+        {
+            const auto err = errno;
+            ::close(fd);
+            errno = err;
+            throw_system_error(path);
+        }
+        ::madvise(p, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const uint8_t*>(p);
+    }
+    ::close(fd);  // The mapping stays valid after the file is closed.
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data != nullptr && m_buffer.empty())
+        ::munmap(const_cast<uint8_t*>(m_data), m_size);
+}
+#else
+MappedFile::MappedFile(const std::string& path)
+{
+    std::ifstream file{path, std::ios::binary};
+    if (!file)
+        throw_system_error(path);
+    m_buffer.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+}
+
+MappedFile::~MappedFile() = default;
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+  : m_data{std::exchange(other.m_data, nullptr)},
+    m_size{std::exchange(other.m_size, 0)},
+    m_buffer{std::move(other.m_buffer)}
+{
+    if (!m_buffer.empty())
+        m_data = m_buffer.data();
+}
+
+bytes load_hex_file(const std::string& path)
+{
+    const MappedFile file{path};
+    const auto data = file.data();
+    auto out = decode_spaced_hex({reinterpret_cast<const char*>(data.data()), data.size()});
+    if (!out)
+        throw std::invalid_argument{"invalid hex in " + path};
+    return std::move(*out);
+}
+}  // namespace evmc::tooling
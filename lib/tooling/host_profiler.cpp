@@ -0,0 +1,31 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <evmc/tooling.hpp>
+
+namespace evmc::tooling
+{
+void HostProfiler::enter(HostMethod method) noexcept
+{
+    if (m_depth++ != 0)
+        return;  // Nested callback: the time is already accounted for the outer one.
+
+    auto& s = m_stats[static_cast<size_t>(method)];
+    m_timing = s.num_calls++ % m_sample_period == 0;
+    if (m_timing)
+        m_start = std::chrono::steady_clock::now();
+}
+
+void HostProfiler::leave(HostMethod method) noexcept
+{
+    if (--m_depth != 0 || !m_timing)
+        return;
+
+    const std::chrono::duration<double, std::nano> latency =
+        std::chrono::steady_clock::now() - m_start;
+    auto& s = m_stats[static_cast<size_t>(method)];
+    ++s.num_timed_calls;
+    s.timed_ns += latency.count();
+}
+}  // namespace evmc::tooling
@@ -0,0 +1,272 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "json.hpp"
+#include <cstdlib>
+#include <stdexcept>
+
+namespace evmc::tooling::json
+{
+namespace
+{
+class Parser
+{
+    std::string_view m_text;
+    size_t m_pos = 0;
+
+public:
+    explicit Parser(std::string_view text) noexcept : m_text{text} {}
+
+    Value parse_document()
+    {
+        auto value = parse_value();
+        skip_space();
+        if (m_pos != m_text.size())
+            error("unexpected trailing characters");
+        return value;
+    }
+
+private:
+    [[noreturn]] void error(const char* msg) const
+    {
+        throw std::invalid_argument{std::string{"invalid JSON: "} + msg + " at offset " +
+                                    std::to_string(m_pos)};
+    }
+
+    void skip_space() noexcept
+    {
+        while (m_pos < m_text.size() && (m_text[m_pos] == ' ' || m_text[m_pos] == '\t' ||
+                                         m_text[m_pos] == '\n' || m_text[m_pos] == '\r'))
+            ++m_pos;
+    }
+
+    char peek()
+    {
+        skip_space();
+        if (m_pos == m_text.size())
+            error("unexpected end");
+        return m_text[m_pos];
+    }
+
+    void expect(char c)
+    {
+        if (peek() != c)
+            error("unexpected character");
+        ++m_pos;
+    }
+
+    bool consume(std::string_view literal) noexcept
+    {
+        if (m_text.substr(m_pos, literal.size()) != literal)
+            return false;
+        m_pos += literal.size();
+        return true;
+    }
+
+    Value parse_value()
+    {
+        switch (peek())
+        {
+        case '{':
+            return {parse_object()};
+        case '[':
+            return {parse_array()};
+        case '"':
+            return {parse_string()};
+        default:
+            if (consume("null"))
+                return {nullptr};
+            if (consume("true"))
+                return {true};
+            if (consume("false"))
+                return {false};
+            return {parse_number()};
+        }
+    }
+
+    Object parse_object()
+    {
+        Object obj;
+        expect('{');
+        if (peek() == '}')
+        {
+            ++m_pos;
+            return obj;
+        }
+        while (true)
+        {
+            if (peek() != '"')
+                error("expected object key");
+            auto key = parse_string();
+            expect(':');
+            obj.insert_or_assign(std::move(key), parse_value());
+            if (peek() == '}')
+            {
+                ++m_pos;
+                return obj;
+            }
+            expect(',');
+        }
+    }
+
+    Array parse_array()
+    {
+        Array arr;
+        expect('[');
+        if (peek() == ']')
+        {
+            ++m_pos;
+            return arr;
+        }
+        while (true)
+        {
+            arr.push_back(parse_value());
+            if (peek() == ']')
+            {
+                ++m_pos;
+                return arr;
+            }
+            expect(',');
+        }
+    }
+
+    std::string parse_string()
+    {
+        expect('"');
+        std::string str;
+        while (true)
+        {
+            if (m_pos == m_text.size())
+                error("unterminated string");
+            const auto c = m_text[m_pos++];
+            if (c == '"')
+                return str;
+            if (c != '\\')
+            {
+                str += c;
+                continue;
+            }
+
+            if (m_pos == m_text.size())
+                error("unterminated string");
+            switch (const auto e = m_text[m_pos++]; e)
+            {
+            case '"':
+            case '\\':
+            case '/':
+                str += e;
+                break;
+            case 'b':
+                str += '\b';
+                break;
+            case 'f':
+                str += '\f';
+                break;
+            case 'n':
+                str += '\n';
+                break;
+            case 'r':
+                str += '\r';
+                break;
+            case 't':
+                str += '\t';
+                break;
+            case 'u':
+            {
+                // Only the code points from the Basic Multilingual Plane are supported.
+                if (m_pos + 4 > m_text.size())
+                    error("invalid unicode escape");
+                const auto cp = std::stoul(std::string{m_text.substr(m_pos, 4)}, nullptr, 16);
+                m_pos += 4;
+                if (cp < 0x80)
+                    str += static_cast<char>(cp);
+                else if (cp < 0x800)
+                {
+                    str += static_cast<char>(0xc0 | (cp >> 6));
+                    str += static_cast<char>(0x80 | (cp & 0x3f));
+                }
+                else
+                {
+                    str += static_cast<char>(0xe0 | (cp >> 12));
+                    str += static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+                    str += static_cast<char>(0x80 | (cp & 0x3f));
+                }
+                break;
+            }
+            default:
+                error("invalid escape sequence");
+            }
+        }
+    }
+
+    double parse_number()
+    {
+        const auto begin = m_pos;
+        while (m_pos < m_text.size() && std::string_view{"+-0123456789.eE"}.find(
+                                            m_text[m_pos]) != std::string_view::npos)
+            ++m_pos;
+        if (begin == m_pos)
+            error("unexpected character");
+
+        const std::string num{m_text.substr(begin, m_pos - begin)};
+        char* end = nullptr;
+        const auto value = std::strtod(num.c_str(), &end);
+        if (end != num.c_str() + num.size())
+            error("invalid number");
+        return value;
+    }
+};
+}  // namespace
+
+Value parse(std::string_view text)
+{
+    return Parser{text}.parse_document();
+}
+
+std::string escape(std::string_view s)
+{
+    static constexpr char hex_digits[] = "0123456789abcdef";
+
+    std::string out;
+    out.reserve(s.size());
+    for (const auto c : s)
+    {
+        const auto u = static_cast<unsigned char>(c);
+        switch (c)
+        {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\b':
+            out += "\\b";
+            break;
+        case '\f':
+            out += "\\f";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\r':
+            out += "\\r";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if (u < 0x20)
+            {
+                out += "\\u00";
+                out += hex_digits[u >> 4];
+                out += hex_digits[u & 0xf];
+            }
+            else
+                out += c;
+        }
+    }
+    return out;
+}
+}  // namespace evmc::tooling::json
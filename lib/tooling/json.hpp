@@ -0,0 +1,54 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+/// Minimal JSON reader for the files consumed by the tooling (e.g. benchmark baselines).
+namespace evmc::tooling::json
+{
+struct Value;
+
+using Array = std::vector<Value>;             ///< JSON array.
+using Object = std::map<std::string, Value>;  ///< JSON object.
+
+/// JSON value.
+struct Value
+{
+    /// The value: null, bool, number, string, array or object.
+    std::variant<std::nullptr_t, bool, double, std::string, Array, Object> v;
+
+    /// Returns the pointer to the value of the given type or null if the type does not match.
+    template <typename T>
+    const T* get() const noexcept
+    {
+        return std::get_if<T>(&v);
+    }
+
+    /// Returns the pointer to the member of the object or null if not found or not an object.
+    const Value* find(const std::string& key) const noexcept
+    {
+        const auto* obj = get<Object>();
+        if (obj == nullptr)
+            return nullptr;
+        const auto it = obj->find(key);
+        return it != obj->end() ? &it->second : nullptr;
+    }
+};
+
+/// Parses the JSON document.
+///
+/// @throws std::invalid_argument in case of invalid input.
+Value parse(std::string_view text);
+
+/// Escapes the string to be used as a JSON string value (without the enclosing quotes).
+///
+/// The quotation mark, the reverse solidus and the control characters are escaped.
+std::string escape(std::string_view s);
+}  // namespace evmc::tooling::json
@@ -0,0 +1,41 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+#pragma once
+
+#include <evmc/bytes.hpp>
+#include <cstdint>
+#include <type_traits>
+
+/// Little-endian encoding of the integers in the binary formats of the tooling
+/// (the state snapshots, the host recordings and the frames of the serve protocol).
+namespace evmc::tooling::le
+{
+/// Stores the integer or the enum value at the given position.
+template <typename T>
+void store(uint8_t* p, T v) noexcept
+{
+    static_assert(std::is_integral_v<T> || std::is_enum_v<T>);
+    for (size_t i = 0; i < sizeof(T); ++i)
+        p[i] = static_cast<uint8_t>(static_cast<uint64_t>(v) >> (8 * i));
+}
+
+/// Appends the integer or the enum value to the output.
+template <typename T>
+void put(bytes& out, T v)
+{
+    out.resize(out.size() + sizeof(T));
+    store(&out[out.size() - sizeof(T)], v);
+}
+
+/// Loads the integer or the enum value from the given position.
+template <typename T>
+T load(const uint8_t* p) noexcept
+{
+    static_assert(std::is_integral_v<T> || std::is_enum_v<T>);
+    uint64_t v = 0;
+    for (size_t i = 0; i < sizeof(T); ++i)
+        v |= uint64_t{p[i]} << (8 * i);
+    return static_cast<T>(v);
+}
+}  // namespace evmc::tooling::le
@@ -0,0 +1,158 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "perf.hpp"
+#include <tuple>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace evmc::tooling
+{
+#ifdef __linux__
+namespace
+{
+/// Returns the perf_event_open() type and config of the event.
+std::pair<uint32_t, uint64_t> event_config(PerfEvent event) noexcept
+{
+    constexpr auto cache_read_miss = [](uint64_t cache) noexcept {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    };
+
+    switch (event)
+    {
+    case PerfEvent::cycles:
+        return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+    case PerfEvent::instructions:
+        return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS};
+    case PerfEvent::branch_misses:
+        return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES};
+    case PerfEvent::l1d_misses:
+        return {PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_L1D)};
+    case PerfEvent::llc_misses:
+        return {PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_LL)};
+    case PerfEvent::dtlb_misses:
+        return {PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_DTLB)};
+    }
+    return {};
+}
+
+int open_event(PerfEvent event) noexcept
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    std::tie(attr.type, attr.config) = event_config(event);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;  // Required for unprivileged users by default.
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // Count the current thread on any CPU.
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+}  // namespace
+
+PerfEventSet::PerfEventSet() noexcept
+{
+    for (size_t i = 0; i < num_perf_events; ++i)
+        m_fds[i] = open_event(static_cast<PerfEvent>(i));
+}
+
+PerfEventSet::~PerfEventSet() noexcept
+{
+    for (const auto fd : m_fds)
+    {
+        if (fd >= 0)
+            close(fd);
+    }
+}
+
+void PerfEventSet::start() noexcept
+{
+    for (const auto fd : m_fds)
+    {
+        if (fd >= 0)
+        {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+void PerfEventSet::stop() noexcept
+{
+    for (const auto fd : m_fds)
+    {
+        if (fd >= 0)
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+}
+
+PerfCounters PerfEventSet::read(uint64_t num_executions) const noexcept
+{
+    PerfCounters counters;
+    for (size_t i = 0; i < num_perf_events; ++i)
+    {
+        struct
+        {
+            uint64_t value;
+            uint64_t time_enabled;
+            uint64_t time_running;
+        } data{};
+
+        if (m_fds[i] < 0 || ::read(m_fds[i], &data, sizeof(data)) != sizeof(data) ||
+            data.time_running == 0 || num_executions == 0)
+            continue;
+
+        const auto scale =
+            static_cast<double>(data.time_enabled) / static_cast<double>(data.time_running);
+        counters.values[i] = static_cast<double>(data.value) * scale /
+                             static_cast<double>(num_executions);
+    }
+    return counters;
+}
+#else
+PerfEventSet::PerfEventSet() noexcept
+{
+    m_fds.fill(-1);
+}
+
+PerfEventSet::~PerfEventSet() noexcept = default;
+
+void PerfEventSet::start() noexcept {}
+
+void PerfEventSet::stop() noexcept {}
+
+PerfCounters PerfEventSet::read(uint64_t /*num_executions*/) const noexcept
+{
+    return {};
+}
+#endif
+
+const char* to_string(PerfEvent event) noexcept
+{
+    switch (event)
+    {
+    case PerfEvent::cycles:
+        return "cycles";
+    case PerfEvent::instructions:
+        return "instructions";
+    case PerfEvent::branch_misses:
+        return "branch_misses";
+    case PerfEvent::l1d_misses:
+        return "l1d_misses";
+    case PerfEvent::llc_misses:
+        return "llc_misses";
+    case PerfEvent::dtlb_misses:
+        return "dtlb_misses";
+    }
+    return "<unknown>";
+}
+}  // namespace evmc::tooling
@@ -0,0 +1,36 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+#pragma once
+
+#include <evmc/tooling.hpp>
+
+namespace evmc::tooling
+{
+/// The hardware performance counters of the current thread.
+///
+/// Every event is opened separately so that the events not supported by the CPU or
+/// not permitted by the system configuration are skipped. When the events are multiplexed
+/// the values are scaled by the fraction of the time they have been actually counted.
+class PerfEventSet
+{
+    std::array<int, num_perf_events> m_fds;
+
+public:
+    /// Opens all available counters (disabled).
+    PerfEventSet() noexcept;
+    ~PerfEventSet() noexcept;
+
+    PerfEventSet(const PerfEventSet&) = delete;
+    PerfEventSet& operator=(const PerfEventSet&) = delete;
+
+    /// Resets and starts the counters.
+    void start() noexcept;
+
+    /// Stops the counters.
+    void stop() noexcept;
+
+    /// Returns the counter values divided by the number of executions.
+    PerfCounters read(uint64_t num_executions) const noexcept;
+};
+}  // namespace evmc::tooling
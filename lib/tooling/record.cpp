@@ -0,0 +1,571 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "le.hpp"
+#include <evmc/tooling.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+namespace evmc::tooling
+{
+namespace
+{
+/// The recording header: the magic and the format version.
+constexpr uint8_t header[] = {'E', 'V', 'M', 'C', 'R', 'E', 'C', 1};
+
+/// The size of the length prefix of a variable-length value.
+constexpr size_t length_size = sizeof(uint32_t);
+
+/// Encoder of the values in the recording format.
+class Writer
+{
+    bytes& m_out;
+
+public:
+    explicit Writer(bytes& out) noexcept : m_out{out} {}
+
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>>
+    Writer& operator<<(T v)
+    {
+        le::put(m_out, v);
+        return *this;
+    }
+
+    Writer& operator<<(const evmc_address& v)
+    {
+        m_out.append(v.bytes, sizeof(v.bytes));
+        return *this;
+    }
+
+    Writer& operator<<(const evmc_bytes32& v)
+    {
+        m_out.append(v.bytes, sizeof(v.bytes));
+        return *this;
+    }
+
+    Writer& operator<<(bytes_view v)
+    {
+        *this << static_cast<uint32_t>(v.size());
+        m_out.append(v);
+        return *this;
+    }
+
+    Writer& operator<<(const evmc_message& msg)
+    {
+        return *this << msg.kind << msg.flags << msg.depth << msg.gas << msg.recipient
+                     << msg.sender << bytes_view{msg.input_data, msg.input_size} << msg.value
+                     << msg.create2_salt << msg.code_address << bytes_view{msg.code, msg.code_size};
+    }
+
+    Writer& operator<<(const Result& result)
+    {
+        return *this << result.status_code << result.gas_left << result.gas_refund
+                     << bytes_view{result.output_data, result.output_size}
+                     << result.create_address;
+    }
+
+    Writer& operator<<(const evmc_tx_context& tx)
+    {
+        *this << tx.tx_gas_price << tx.tx_origin << tx.block_coinbase << tx.block_number
+              << tx.block_timestamp << tx.block_gas_limit << tx.block_prev_randao << tx.chain_id
+              << tx.block_base_fee << tx.blob_base_fee
+              << bytes_view{reinterpret_cast<const uint8_t*>(tx.blob_hashes),
+                            tx.blob_hashes_count * sizeof(evmc_bytes32)}
+              << static_cast<uint64_t>(tx.initcodes_count);
+        for (size_t i = 0; i < tx.initcodes_count; ++i)
+        {
+            const auto& initcode = tx.initcodes[i];
+            *this << initcode.hash << bytes_view{initcode.code, initcode.code_size};
+        }
+        return *this;
+    }
+};
+
+/// Decoder of the values in the recording format.
+///
+/// Reading past the end of the input returns zero values and sets the error flag.
+class Reader
+{
+    bytes_view m_in;
+    bool& m_error;
+
+public:
+    Reader(bytes_view in, bool& error) noexcept : m_in{in}, m_error{error} {}
+
+    /// Returns the number of bytes not read yet.
+    size_t remaining() const noexcept { return m_in.size(); }
+
+    template <typename T>
+    T get() noexcept
+    {
+        if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+        {
+            if (!has(sizeof(T)))
+                return T{};
+            const auto v = le::load<T>(m_in.data());
+            m_in.remove_prefix(sizeof(T));
+            return v;
+        }
+        else if constexpr (std::is_same_v<T, bytes_view>)
+        {
+            const auto size = get<uint32_t>();
+            if (!has(size))
+                return {};
+            const auto v = m_in.substr(0, size);
+            m_in.remove_prefix(size);
+            return v;
+        }
+        else
+        {
+            T v{};
+            if (!has(sizeof(v.bytes)))
+                return v;
+            std::memcpy(v.bytes, m_in.data(), sizeof(v.bytes));
+            m_in.remove_prefix(sizeof(v.bytes));
+            return v;
+        }
+    }
+
+private:
+    bool has(size_t size) noexcept
+    {
+        if (m_in.size() >= size)
+            return true;
+        m_error = true;
+        m_in = {};
+        return false;
+    }
+};
+
+/// Appends the values to the output as the length-prefixed section.
+template <typename... Ts>
+void put_section(bytes& out, const Ts&... values)
+{
+    const auto size_pos = out.size();
+    out.resize(size_pos + length_size);
+    Writer w{out};
+    ((w << values), ...);
+    le::store(&out[size_pos], static_cast<uint32_t>(out.size() - size_pos - length_size));
+}
+
+/// Appends the record of the host method call to the recording.
+template <typename... Args, typename... Results>
+void put_record(bytes& recording,
+                HostMethod method,
+                const std::tuple<Args...>& args,
+                const std::tuple<Results...>& results)
+{
+    recording.push_back(static_cast<uint8_t>(method));
+    std::apply([&](const auto&... a) { put_section(recording, a...); }, args);
+    std::apply([&](const auto&... r) { put_section(recording, r...); }, results);
+}
+
+/// Encodes the arguments of the host method call into the buffer.
+template <typename... Args>
+void encode_args(bytes& out, const Args&... args)
+{
+    out.clear();
+    Writer w{out};
+    ((w << args), ...);
+}
+
+/// Returns the view of the array of bytes32 values as bytes.
+bytes_view as_bytes(const bytes32 values[], size_t count) noexcept
+{
+    return {reinterpret_cast<const uint8_t*>(values), count * sizeof(bytes32)};
+}
+}  // namespace
+
+const char* to_string(HostMethod method) noexcept
+{
+    switch (method)
+    {
+    case HostMethod::account_exists:
+        return "account_exists";
+    case HostMethod::get_storage:
+        return "get_storage";
+    case HostMethod::set_storage:
+        return "set_storage";
+    case HostMethod::get_balance:
+        return "get_balance";
+    case HostMethod::get_code_size:
+        return "get_code_size";
+    case HostMethod::get_code_hash:
+        return "get_code_hash";
+    case HostMethod::copy_code:
+        return "copy_code";
+    case HostMethod::selfdestruct:
+        return "selfdestruct";
+    case HostMethod::call:
+        return "call";
+    case HostMethod::get_tx_context:
+        return "get_tx_context";
+    case HostMethod::get_block_hash:
+        return "get_block_hash";
+    case HostMethod::emit_log:
+        return "emit_log";
+    case HostMethod::access_account:
+        return "access_account";
+    case HostMethod::access_storage:
+        return "access_storage";
+    case HostMethod::get_transient_storage:
+        return "get_transient_storage";
+    case HostMethod::set_transient_storage:
+        return "set_transient_storage";
+    case HostMethod::allocate_output:
+        return "allocate_output";
+    }
+    return "<unknown>";
+}
+
+RecordingHost::RecordingHost(HostInterface& host) : m_host{host}
+{
+    m_recording.assign(std::begin(header), std::end(header));
+}
+
+bool RecordingHost::account_exists(const address& addr) const noexcept
+{
+    const auto result = m_host.account_exists(addr);
+    put_record(m_recording, HostMethod::account_exists, std::tie(addr), std::tie(result));
+    return result;
+}
+
+bytes32 RecordingHost::get_storage(const address& addr, const bytes32& key) const noexcept
+{
+    const auto result = m_host.get_storage(addr, key);
+    put_record(m_recording, HostMethod::get_storage, std::tie(addr, key), std::tie(result));
+    return result;
+}
+
+evmc_storage_status RecordingHost::set_storage(const address& addr,
+                                               const bytes32& key,
+                                               const bytes32& value) noexcept
+{
+    const auto result = m_host.set_storage(addr, key, value);
+    put_record(m_recording, HostMethod::set_storage, std::tie(addr, key, value), std::tie(result));
+    return result;
+}
+
+uint256be RecordingHost::get_balance(const address& addr) const noexcept
+{
+    const auto result = m_host.get_balance(addr);
+    put_record(m_recording, HostMethod::get_balance, std::tie(addr), std::tie(result));
+    return result;
+}
+
+size_t RecordingHost::get_code_size(const address& addr) const noexcept
+{
+    const auto result = m_host.get_code_size(addr);
+    put_record(m_recording, HostMethod::get_code_size, std::tie(addr),
+               std::make_tuple(static_cast<uint64_t>(result)));
+    return result;
+}
+
+bytes32 RecordingHost::get_code_hash(const address& addr) const noexcept
+{
+    const auto result = m_host.get_code_hash(addr);
+    put_record(m_recording, HostMethod::get_code_hash, std::tie(addr), std::tie(result));
+    return result;
+}
+
+size_t RecordingHost::copy_code(const address& addr,
+                                size_t code_offset,
+                                uint8_t* buffer_data,
+                                size_t buffer_size) const noexcept
+{
+    const auto result = m_host.copy_code(addr, code_offset, buffer_data, buffer_size);
+    put_record(m_recording, HostMethod::copy_code,
+               std::make_tuple(addr, static_cast<uint64_t>(code_offset),
+                               static_cast<uint64_t>(buffer_size)),
+               std::make_tuple(bytes_view{buffer_data, result}));
+    return result;
+}
+
+bool RecordingHost::selfdestruct(const address& addr, const address& beneficiary) noexcept
+{
+    const auto result = m_host.selfdestruct(addr, beneficiary);
+    put_record(m_recording, HostMethod::selfdestruct, std::tie(addr, beneficiary),
+               std::tie(result));
+    return result;
+}
+
+Result RecordingHost::call(const evmc_message& msg) noexcept
+{
+    auto result = m_host.call(msg);
+    put_record(m_recording, HostMethod::call, std::tie(msg), std::tie(result));
+    return result;
+}
+
+evmc_tx_context RecordingHost::get_tx_context() const noexcept
+{
+    const auto result = m_host.get_tx_context();
+    put_record(m_recording, HostMethod::get_tx_context, std::make_tuple(), std::tie(result));
+    return result;
+}
+
+bytes32 RecordingHost::get_block_hash(int64_t block_number) const noexcept
+{
+    const auto result = m_host.get_block_hash(block_number);
+    put_record(m_recording, HostMethod::get_block_hash, std::tie(block_number), std::tie(result));
+    return result;
+}
+
+void RecordingHost::emit_log(const address& addr,
+                             const uint8_t* data,
+                             size_t data_size,
+                             const bytes32 topics[],
+                             size_t num_topics) noexcept
+{
+    m_host.emit_log(addr, data, data_size, topics, num_topics);
+    put_record(m_recording, HostMethod::emit_log,
+               std::make_tuple(addr, bytes_view{data, data_size}, as_bytes(topics, num_topics)),
+               std::make_tuple());
+}
+
+evmc_access_status RecordingHost::access_account(const address& addr) noexcept
+{
+    const auto result = m_host.access_account(addr);
+    put_record(m_recording, HostMethod::access_account, std::tie(addr), std::tie(result));
+    return result;
+}
+
+evmc_access_status RecordingHost::access_storage(const address& addr, const bytes32& key) noexcept
+{
+    const auto result = m_host.access_storage(addr, key);
+    put_record(m_recording, HostMethod::access_storage, std::tie(addr, key), std::tie(result));
+    return result;
+}
+
+bytes32 RecordingHost::get_transient_storage(const address& addr,
+                                             const bytes32& key) const noexcept
+{
+    const auto result = m_host.get_transient_storage(addr, key);
+    put_record(m_recording, HostMethod::get_transient_storage, std::tie(addr, key),
+               std::tie(result));
+    return result;
+}
+
+void RecordingHost::set_transient_storage(const address& addr,
+                                          const bytes32& key,
+                                          const bytes32& value) noexcept
+{
+    m_host.set_transient_storage(addr, key, value);
+    put_record(m_recording, HostMethod::set_transient_storage, std::tie(addr, key, value),
+               std::make_tuple());
+}
+
+uint8_t* RecordingHost::allocate_output(size_t size) noexcept
+{
+    return m_host.allocate_output(size);
+}
+
+
+ReplayHost::ReplayHost(bytes recording, HostInterface* host)
+  : m_recording{std::move(recording)}, m_host{host}
+{
+    if (m_recording.size() < std::size(header) ||
+        !std::equal(std::begin(header), std::end(header), m_recording.begin()))
+        throw std::invalid_argument{"invalid host recording: unknown format"};
+
+    // Validate the structure of all the records so that the replay only needs to check
+    // the contents.
+    bool error = false;
+    Reader r{bytes_view{m_recording}.substr(std::size(header)), error};
+    while (r.remaining() != 0 && !error)
+    {
+        // The allocations are not recorded.
+        if (r.get<uint8_t>() >= static_cast<uint8_t>(HostMethod::allocate_output))
+            throw std::invalid_argument{"invalid host recording: unknown host method"};
+        r.get<bytes_view>();
+        r.get<bytes_view>();
+    }
+    if (error)
+        throw std::invalid_argument{"invalid host recording: truncated record"};
+
+    rewind();
+}
+
+void ReplayHost::rewind(std::optional<size_t> position) noexcept
+{
+    m_position = position.value_or(std::size(header));
+    m_diverged = false;
+}
+
+bytes_view ReplayHost::next(HostMethod method) const noexcept
+{
+    if (m_diverged || finished())
+    {
+        m_diverged = true;
+        return {};
+    }
+
+    Reader r{bytes_view{m_recording}.substr(m_position), m_diverged};
+    const auto recorded_method = r.get<HostMethod>();
+    const auto args = r.get<bytes_view>();
+    const auto results = r.get<bytes_view>();
+    if (recorded_method != method || args != bytes_view{m_args})
+    {
+        m_diverged = true;
+        return {};
+    }
+    m_position = m_recording.size() - r.remaining();
+    return results;
+}
+
+bool ReplayHost::account_exists(const address& addr) const noexcept
+{
+    encode_args(m_args, addr);
+    return Reader{next(HostMethod::account_exists), m_diverged}.get<bool>();
+}
+
+bytes32 ReplayHost::get_storage(const address& addr, const bytes32& key) const noexcept
+{
+    encode_args(m_args, addr, key);
+    return Reader{next(HostMethod::get_storage), m_diverged}.get<bytes32>();
+}
+
+evmc_storage_status ReplayHost::set_storage(const address& addr,
+                                            const bytes32& key,
+                                            const bytes32& value) noexcept
+{
+    encode_args(m_args, addr, key, value);
+    return Reader{next(HostMethod::set_storage), m_diverged}.get<evmc_storage_status>();
+}
+
+uint256be ReplayHost::get_balance(const address& addr) const noexcept
+{
+    encode_args(m_args, addr);
+    return Reader{next(HostMethod::get_balance), m_diverged}.get<uint256be>();
+}
+
+size_t ReplayHost::get_code_size(const address& addr) const noexcept
+{
+    encode_args(m_args, addr);
+    return static_cast<size_t>(Reader{next(HostMethod::get_code_size), m_diverged}.get<uint64_t>());
+}
+
+bytes32 ReplayHost::get_code_hash(const address& addr) const noexcept
+{
+    encode_args(m_args, addr);
+    return Reader{next(HostMethod::get_code_hash), m_diverged}.get<bytes32>();
+}
+
+size_t ReplayHost::copy_code(const address& addr,
+                             size_t code_offset,
+                             uint8_t* buffer_data,
+                             size_t buffer_size) const noexcept
+{
+    encode_args(m_args, addr, static_cast<uint64_t>(code_offset),
+                static_cast<uint64_t>(buffer_size));
+    const auto code = Reader{next(HostMethod::copy_code), m_diverged}.get<bytes_view>();
+    const auto n = std::min(code.size(), buffer_size);
+    std::copy_n(code.data(), n, buffer_data);
+    return n;
+}
+
+bool ReplayHost::selfdestruct(const address& addr, const address& beneficiary) noexcept
+{
+    encode_args(m_args, addr, beneficiary);
+    return Reader{next(HostMethod::selfdestruct), m_diverged}.get<bool>();
+}
+
+Result ReplayHost::call(const evmc_message& msg) noexcept
+{
+    encode_args(m_args, msg);
+    Reader r{next(HostMethod::call), m_diverged};
+    const auto status = r.get<evmc_status_code>();
+    const auto gas_left = r.get<int64_t>();
+    const auto gas_refund = r.get<int64_t>();
+    const auto output = r.get<bytes_view>();
+    Result result{status, gas_left, gas_refund, output.data(), output.size()};
+    result.create_address = r.get<address>();
+    if (m_diverged)
+        result.status_code = EVMC_INTERNAL_ERROR;
+    return result;
+}
+
+evmc_tx_context ReplayHost::get_tx_context() const noexcept
+{
+    encode_args(m_args);
+    Reader r{next(HostMethod::get_tx_context), m_diverged};
+    evmc_tx_context tx{};
+    tx.tx_gas_price = r.get<uint256be>();
+    tx.tx_origin = r.get<address>();
+    tx.block_coinbase = r.get<address>();
+    tx.block_number = r.get<int64_t>();
+    tx.block_timestamp = r.get<int64_t>();
+    tx.block_gas_limit = r.get<int64_t>();
+    tx.block_prev_randao = r.get<uint256be>();
+    tx.chain_id = r.get<uint256be>();
+    tx.block_base_fee = r.get<uint256be>();
+    tx.blob_base_fee = r.get<uint256be>();
+
+    // The blob hashes and the initcodes point directly to the recording.
+    const auto blob_hashes = r.get<bytes_view>();
+    tx.blob_hashes = reinterpret_cast<const evmc_bytes32*>(blob_hashes.data());
+    tx.blob_hashes_count = blob_hashes.size() / sizeof(evmc_bytes32);
+
+    m_initcodes.clear();
+    const auto initcodes_count = r.get<uint64_t>();
+    for (uint64_t i = 0; i < initcodes_count && !m_diverged; ++i)
+    {
+        const auto hash = r.get<bytes32>();
+        const auto code = r.get<bytes_view>();
+        m_initcodes.push_back({hash, code.data(), code.size()});
+    }
+    tx.initcodes = m_initcodes.data();
+    tx.initcodes_count = m_initcodes.size();
+    return tx;
+}
+
+bytes32 ReplayHost::get_block_hash(int64_t block_number) const noexcept
+{
+    encode_args(m_args, block_number);
+    return Reader{next(HostMethod::get_block_hash), m_diverged}.get<bytes32>();
+}
+
+void ReplayHost::emit_log(const address& addr,
+                          const uint8_t* data,
+                          size_t data_size,
+                          const bytes32 topics[],
+                          size_t num_topics) noexcept
+{
+    encode_args(m_args, addr, bytes_view{data, data_size}, as_bytes(topics, num_topics));
+    next(HostMethod::emit_log);
+}
+
+evmc_access_status ReplayHost::access_account(const address& addr) noexcept
+{
+    encode_args(m_args, addr);
+    return Reader{next(HostMethod::access_account), m_diverged}.get<evmc_access_status>();
+}
+
+evmc_access_status ReplayHost::access_storage(const address& addr, const bytes32& key) noexcept
+{
+    encode_args(m_args, addr, key);
+    return Reader{next(HostMethod::access_storage), m_diverged}.get<evmc_access_status>();
+}
+
+bytes32 ReplayHost::get_transient_storage(const address& addr, const bytes32& key) const noexcept
+{
+    encode_args(m_args, addr, key);
+    return Reader{next(HostMethod::get_transient_storage), m_diverged}.get<bytes32>();
+}
+
+void ReplayHost::set_transient_storage(const address& addr,
+                                       const bytes32& key,
+                                       const bytes32& value) noexcept
+{
+    encode_args(m_args, addr, key, value);
+    next(HostMethod::set_transient_storage);
+}
+
+uint8_t* ReplayHost::allocate_output(size_t size) noexcept
+{
+    return m_host != nullptr ? m_host->allocate_output(size) : nullptr;
+}
+}  // namespace evmc::tooling
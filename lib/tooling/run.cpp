@@ -6,8 +6,13 @@
 #include <evmc/hex.hpp>
 #include <evmc/mocked_host.hpp>
 #include <evmc/tooling.hpp>
-#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <optional>
 #include <ostream>
+#include <sstream>
+#include <stdexcept>
 
 namespace evmc::tooling
 {
@@ -22,42 +27,121 @@ constexpr auto create_gas = 10'000'000;
 /// MAGIC bytes denoting an EOF container.
 constexpr uint8_t MAGIC[] = {0xef, 0x00};
 
-auto bench(MockedHost& host,
+void bench(Host& host,
            evmc::VM& vm,
            evmc_revision rev,
            const evmc_message& msg,
            bytes_view code,
            const evmc::Result& expected_result,
+           const BenchOptions& options,
+           const std::function<void()>& reset,
+           const FlatMockedHost& scaling_state,
            std::ostream& out)
 {
+    constexpr auto warning =
+        "WARNING! Inconsistent execution result likely due to the use of storage ";
+
+    // Probe run: execute once again the already warm code to check the result consistency.
     {
-        using clock = std::chrono::steady_clock;
-        using unit = std::chrono::nanoseconds;
-        constexpr auto unit_name = " ns";
-        constexpr auto target_bench_time = std::chrono::seconds{1};
-        constexpr auto warning =
-            "WARNING! Inconsistent execution result likely due to the use of storage ";
-
-        // Probe run: execute once again the already warm code to estimate a single run time.
-        const auto probe_start = clock::now();
         const auto result = vm.execute(host, rev, msg, code.data(), code.size());
-        const auto bench_start = clock::now();
-        const auto probe_time = bench_start - probe_start;
-
+        if (reset)
+            reset();
         if (result.gas_left != expected_result.gas_left)
             out << warning << "(gas used: " << (msg.gas - result.gas_left) << ")\n";
         if (bytes_view{result.output_data, result.output_size} !=
             bytes_view{expected_result.output_data, expected_result.output_size})
             out << warning << "(output: " << hex({result.output_data, result.output_size}) << ")\n";
+    }
 
-        // Benchmark loop.
-        const auto num_iterations = std::max(static_cast<int>(target_bench_time / probe_time), 1);
-        for (int i = 0; i < num_iterations; ++i)
-            vm.execute(host, rev, msg, code.data(), code.size());
-        const auto bench_time = (clock::now() - bench_start) / num_iterations;
+    const auto r = measure(host, vm, rev, msg, code, options, reset);
+    const auto& s = r.stats;
+    const auto int_ns = [](double t) { return std::llround(t); };
+    out << "Time:     " << int_ns(s.median) << " ns (median of " << s.num_samples
+        << " samples, " << r.batch_size << " iterations each)\n"
+        << "          min: " << int_ns(s.min) << " ns, p90: " << int_ns(s.p90)
+        << " ns, p99: " << int_ns(s.p99) << " ns, stddev: " << int_ns(s.stddev) << " ns ("
+        << std::llround(s.mean > 0 ? s.stddev * 100 / s.mean : 0) << "%)\n"
+        << "          mean: " << int_ns(s.mean) << " ns, 95% CI: [" << int_ns(s.ci95_low) << ", "
+        << int_ns(s.ci95_high) << "] ns, outliers: " << s.num_outliers << "\n";
+    if (r.perf)
+    {
+        // Format into a local stream to not modify the formatting flags of the output stream.
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(1) << "Counters:";
+        auto any = false;
+        for (size_t i = 0; i < num_perf_events; ++i)
+        {
+            if (const auto& v = r.perf->values[i]; v)
+            {
+                line << (any ? ", " : " ") << *v << " " << to_string(static_cast<PerfEvent>(i));
+                any = true;
+            }
+        }
+        if (!any)
+            line << " not available";
+        else
+        {
+            line << " per execution";
+            if (const auto ipc = r.perf->ipc(); ipc)
+                line << std::setprecision(2) << ", IPC: " << *ipc;
+        }
+        out << line.str() << "\n";
+    }
+    if (const auto& p = r.host_profile; p)
+    {
+        std::ostringstream lines;
+        lines << std::fixed << std::setprecision(1) << "Host:     " << p->host_fraction() * 100
+              << "% of time in " << p->calls_per_execution()
+              << " callbacks per execution (VM: " << (1 - p->host_fraction()) * 100 << "%)\n";
+        for (size_t i = 0; i < num_host_methods; ++i)
+        {
+            const auto& m = p->methods[i];
+            if (m.num_calls == 0)
+                continue;
+            lines << "          " << to_string(static_cast<HostMethod>(i)) << ": "
+                  << static_cast<double>(m.num_calls) / static_cast<double>(p->num_executions)
+                  << " calls, " << m.mean_latency() << " ns mean latency\n";
+        }
+        out << lines.str();
+    }
+    if (options.track_allocations)
+    {
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(1) << "Allocs:   ";
+        if (const auto& a = r.allocs; a)
+        {
+            line << "VM: " << a->vm.num_allocations << " (" << a->vm.bytes_allocated
+                 << " bytes), host: " << a->host.num_allocations << " ("
+                 << a->host.bytes_allocated << " bytes) per execution, peak live: "
+                 << a->peak_live_bytes << " bytes";
+        }
+        else
+            line << "not available (requires glibc and the allocation hooks, no sanitizers)";
+        out << line.str() << "\n";
+    }
+    out << "Gas rate: " << std::round(r.gas_rate() * 1000) / 1000 << " Mgas/s\n";
+
+    if (options.report != nullptr)
+        write_report(*options.report, options.report_format, r);
 
-        out << "Time:     " << std::chrono::duration_cast<unit>(bench_time).count() << unit_name
-            << " (avg of " << num_iterations << " iterations)\n";
+    if (options.num_threads > 1)
+    {
+        const auto scaling = measure_scaling(vm, rev, msg, code, scaling_state, options);
+        const auto int_rate = [](double t) { return std::llround(t); };
+        const auto total = scaling.throughput();
+        out << "Scaling:  1 thread: " << int_rate(scaling.single_thread_throughput)
+            << " exec/s\n"
+            << "          " << scaling.threads.size() << " threads: " << int_rate(total)
+            << " exec/s (" << std::round(total * static_cast<double>(scaling.gas_used) / 1e3) / 1e3
+            << " Mgas/s), efficiency: " << std::round(scaling.efficiency() * 1000) / 10 << "%\n";
+        for (size_t i = 0; i < scaling.threads.size(); ++i)
+        {
+            const auto& t = scaling.threads[i];
+            out << "          thread " << i;
+            if (t.cpu >= 0)
+                out << " (cpu " << t.cpu << ")";
+            out << ": " << int_rate(t.throughput) << " exec/s\n";
+        }
     }
 }
 
@@ -72,20 +156,35 @@ int run(VM& vm,
         int64_t gas,
         bytes_view code,
         bytes_view input,
-        bool create,
-        bool bench,
+        const RunOptions& options,
         std::ostream& out)
 {
+    if (options.replay != nullptr && options.bench && options.bench->num_threads > 1)
+        throw std::invalid_argument{"multi-threaded benchmark does not support host replay"};
+
+    const auto create = options.create;
     out << (create ? "Creating and executing on " : "Executing on ") << rev << " with " << gas
         << " gas limit\n";
 
-    MockedHost host;
+    // The host serving the state: the MockedHost or the replay of the recorded callbacks.
+    FlatMockedHost mocked_host;
+    if (options.state != nullptr)
+        mocked_host.accounts = std::move(*options.state);
+    Host& state_host =
+        options.replay != nullptr ? *options.replay : static_cast<Host&>(mocked_host);
+
+    // All the executions are recorded with the recording host, the benchmark iterations are not.
+    std::optional<RecordingHost> recording_host;
+    if (options.record != nullptr)
+        recording_host.emplace(state_host);
+    Host& host = recording_host ? *recording_host : state_host;
 
     evmc_message msg{};
     msg.gas = gas;
     msg.input_data = input.data();
     msg.input_size = input.size();
 
+    bytes created_code;
     bytes_view exec_code = code;
     if (create)
     {
@@ -101,18 +200,53 @@ int run(VM& vm,
             return create_result.status_code;
         }
 
-        auto& created_account = host.accounts[create_address];
+        auto& created_account = mocked_host.accounts[create_address];
         created_account.code = bytes(create_result.output_data, create_result.output_size);
 
+        // The copy of the code, because the account may be moved by the later insertions.
+        created_code = created_account.code;
         msg.recipient = create_address;
-        exec_code = created_account.code;
+        exec_code = created_code;
     }
     out << "\n";
 
+    // The copy of the initial state for the multi-threaded benchmark, taken before the
+    // executions modify the state (which is not restored without the state isolation).
+    std::optional<FlatMockedHost> scaling_state;
+    if (options.bench && options.bench->num_threads > 1)
+        scaling_state = mocked_host;
+
+    // Prepare the restoration of the initial state after every benchmark execution:
+    // rewind the replay to the start of the execution or revert to the state checkpoint.
+    std::function<void()> reset;
+    if (options.replay != nullptr)
+        reset = [replay = options.replay, position = options.replay->position()] {
+            replay->rewind(position);
+        };
+    else if (options.bench && options.bench->isolate_state)
+        reset = [&mocked_host, checkpoint = mocked_host.checkpoint()] {
+            mocked_host.revert(checkpoint);
+        };
+
     const auto result = vm.execute(host, rev, msg, exec_code.data(), exec_code.size());
 
-    if (bench)
-        tooling::bench(host, vm, rev, msg, exec_code, result, out);
+    if (options.replay != nullptr && options.replay->diverged())
+        out << "WARNING! Execution diverged from the host recording\n";
+
+    if (options.record != nullptr)
+    {
+        const auto& recording = recording_host->recording();
+        options.record->write(reinterpret_cast<const char*>(recording.data()),
+                              static_cast<std::streamsize>(recording.size()));
+    }
+
+    if (options.bench)
+    {
+        if (reset)
+            reset();
+        tooling::bench(state_host, vm, rev, msg, exec_code, result, *options.bench, reset,
+                       scaling_state ? *scaling_state : mocked_host, out);
+    }
 
     const auto gas_used = msg.gas - result.gas_left;
     out << "Result:   " << result.status_code << "\nGas used: " << gas_used << "\n";
@@ -122,4 +256,20 @@ int run(VM& vm,
 
     return 0;
 }
+
+int run(VM& vm,
+        evmc_revision rev,
+        int64_t gas,
+        bytes_view code,
+        bytes_view input,
+        bool create,
+        bool bench,
+        std::ostream& out)
+{
+    RunOptions options;
+    options.create = create;
+    if (bench)
+        options.bench.emplace();
+    return run(vm, rev, gas, code, input, options, out);
+}
 }  // namespace evmc::tooling
@@ -0,0 +1,446 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "le.hpp"
+#include <evmc/mocked_host.hpp>
+#include <evmc/tooling.hpp>
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#define EVMC_TOOLING_UNIX_SOCKETS 1
+#endif
+
+namespace evmc::tooling
+{
+namespace
+{
+/// The number of requests (and responses) buffered between the I/O threads and the executor.
+constexpr size_t channel_capacity = 64;
+
+/// The maximum size of the request frame. The frame buffer is allocated before the frame
+/// is read, so the size prefix must be limited.
+constexpr uint32_t max_request_size = 64 * 1024 * 1024;
+
+/// The bounded blocking FIFO queue passing the items between threads.
+template <typename T>
+class Channel
+{
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<T> m_queue;
+    bool m_closed = false;
+
+public:
+    /// Pushes the item, blocking while the channel is full. Returns false if closed.
+    bool push(T item)
+    {
+        std::unique_lock lock{m_mutex};
+        m_cv.wait(lock, [this] { return m_closed || m_queue.size() < channel_capacity; });
+        if (m_closed)
+            return false;
+        m_queue.push_back(std::move(item));
+        m_cv.notify_all();
+        return true;
+    }
+
+    /// Pops the item, blocking while the channel is empty. Returns nothing if closed and empty.
+    std::optional<T> pop()
+    {
+        std::unique_lock lock{m_mutex};
+        m_cv.wait(lock, [this] { return m_closed || !m_queue.empty(); });
+        if (m_queue.empty())
+            return {};
+        auto item = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_cv.notify_all();
+        return item;
+    }
+
+    /// Returns true if there are no items buffered.
+    bool empty()
+    {
+        const std::lock_guard lock{m_mutex};
+        return m_queue.empty();
+    }
+
+    /// Closes the channel. The buffered items can still be popped.
+    void close()
+    {
+        const std::lock_guard lock{m_mutex};
+        m_closed = true;
+        m_cv.notify_all();
+    }
+};
+
+/// The decoded execution request.
+struct Request
+{
+    uint64_t id = 0;
+    uint32_t rev = 0;
+    int64_t gas = 0;
+    bytes code;
+    bytes input;
+    std::string state_path;
+};
+
+/// Decoder of the request frame. Reading past the end of the frame throws.
+class FrameReader
+{
+    bytes_view m_in;
+
+public:
+    explicit FrameReader(bytes_view in) noexcept : m_in{in} {}
+
+    template <typename T>
+    T get()
+    {
+        return le::load<T>(take(sizeof(T)).data());
+    }
+
+    bytes_view get_bytes() { return take(get<uint32_t>()); }
+
+    bool empty() const noexcept { return m_in.empty(); }
+
+private:
+    bytes_view take(size_t size)
+    {
+        if (m_in.size() < size)
+            throw std::invalid_argument{"malformed request: truncated frame"};
+        const auto v = m_in.substr(0, size);
+        m_in.remove_prefix(size);
+        return v;
+    }
+};
+
+/// Reads the next request frame. Returns nothing at the end of the input.
+std::optional<Request> read_request(std::istream& in)
+{
+    std::array<uint8_t, sizeof(uint32_t)> size_prefix{};
+    in.read(reinterpret_cast<char*>(size_prefix.data()), size_prefix.size());
+    if (in.gcount() == 0 && in.eof())
+        return {};
+    if (in.gcount() != static_cast<std::streamsize>(size_prefix.size()))
+        throw std::invalid_argument{"malformed request: truncated frame size"};
+
+    const auto frame_size = le::load<uint32_t>(size_prefix.data());
+    if (frame_size > max_request_size)
+        throw std::invalid_argument{"malformed request: frame too large"};
+
+    bytes frame(frame_size, 0);
+    in.read(reinterpret_cast<char*>(frame.data()), static_cast<std::streamsize>(frame.size()));
+    if (in.gcount() != static_cast<std::streamsize>(frame.size()))
+        throw std::invalid_argument{"malformed request: truncated frame"};
+
+    FrameReader r{frame};
+    Request req;
+    req.id = r.get<uint64_t>();
+    req.rev = r.get<uint32_t>();
+    req.gas = r.get<int64_t>();
+    req.code = r.get_bytes();
+    req.input = r.get_bytes();
+    const auto state_path = r.get_bytes();
+    req.state_path.assign(reinterpret_cast<const char*>(state_path.data()), state_path.size());
+    if (!r.empty())
+        throw std::invalid_argument{"malformed request: unexpected trailing data"};
+    return req;
+}
+
+/// Encodes the response frame.
+bytes encode_response(uint64_t id,
+                      evmc_status_code status,
+                      int64_t gas_left,
+                      int64_t gas_refund,
+                      bytes_view output)
+{
+    bytes frame;
+    frame.reserve(sizeof(uint32_t) + 32 + output.size());
+    le::put(frame, uint32_t{0});  // The frame size placeholder.
+    le::put(frame, id);
+    le::put(frame, static_cast<int32_t>(status));
+    le::put(frame, gas_left);
+    le::put(frame, gas_refund);
+    le::put(frame, static_cast<uint32_t>(output.size()));
+    frame.append(output);
+
+    le::store(frame.data(), static_cast<uint32_t>(frame.size() - sizeof(uint32_t)));
+    return frame;
+}
+
+/// The states loaded from the state files, by path. Every state has the checkpoint 0
+/// the executions are reverted to.
+class StateCache
+{
+    std::map<std::string, FlatMockedHost> m_hosts;
+
+public:
+    FlatMockedHost& get(const std::string& path)
+    {
+        const auto it = m_hosts.find(path);
+        if (it != m_hosts.end())
+            return it->second;
+
+        auto state = path.empty() ? State{} : load_state(path);
+        auto& host = m_hosts[path];
+        host.accounts = std::move(state);
+        host.checkpoint();
+        return host;
+    }
+};
+
+bytes execute(VM& vm, StateCache& states, const Request& req)
+{
+    const auto reject = [&req](const std::string& error) {
+        return encode_response(req.id, EVMC_REJECTED, 0, 0,
+                               {reinterpret_cast<const uint8_t*>(error.data()), error.size()});
+    };
+
+    if (req.rev > EVMC_MAX_REVISION)
+        return reject("unknown revision " + std::to_string(req.rev));
+
+    FlatMockedHost* host = nullptr;
+    try
+    {
+        host = &states.get(req.state_path);
+    }
+    catch (const std::exception& e)
+    {
+        return reject(e.what());
+    }
+
+    evmc_message msg{};
+    msg.gas = req.gas;
+    msg.input_data = req.input.data();
+    msg.input_size = req.input.size();
+    const auto result = vm.execute(*host, static_cast<evmc_revision>(req.rev), msg,
+                                   req.code.data(), req.code.size());
+    host->revert(0);
+    return encode_response(req.id, result.status_code, result.gas_left, result.gas_refund,
+                           {result.output_data, result.output_size});
+}
+
+#ifdef EVMC_TOOLING_UNIX_SOCKETS
+/// The stream buffer reading from or writing to the socket.
+class SocketStreamBuf : public std::streambuf
+{
+    int m_fd;
+    std::array<char, 1 << 16> m_buffer{};
+
+public:
+    explicit SocketStreamBuf(int fd) noexcept : m_fd{fd}
+    {
+        setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+    }
+
+protected:
+    int_type underflow() override
+    {
+        ssize_t n = 0;
+        do
+            n = ::recv(m_fd, m_buffer.data(), m_buffer.size(), 0);
+        while (n < 0 && errno == EINTR);
+        if (n <= 0)
+            return traits_type::eof();
+        setg(m_buffer.data(), m_buffer.data(), m_buffer.data() + n);
+        return traits_type::to_int_type(*gptr());
+    }
+
+    int_type overflow(int_type c) override
+    {
+        if (sync() != 0)
+            return traits_type::eof();
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int sync() override
+    {
+#ifdef MSG_NOSIGNAL
+        constexpr int flags = MSG_NOSIGNAL;  // Report the closed connection as error.
+#else
+        constexpr int flags = 0;  // SO_NOSIGPIPE is set on the connection instead.
+#endif
+        for (const char* p = pbase(); p != pptr();)
+        {
+            const auto n = ::send(m_fd, p, static_cast<size_t>(pptr() - p), flags);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                return -1;
+            p += n;
+        }
+        setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+        return 0;
+    }
+};
+
+/// Owns the file descriptor.
+class FileDescriptor
+{
+    int m_fd;
+
+public:
+    explicit FileDescriptor(int fd) noexcept : m_fd{fd} {}
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+    ~FileDescriptor()
+    {
+        if (m_fd >= 0)
+            ::close(m_fd);
+    }
+
+    int get() const noexcept { return m_fd; }
+};
+#endif
+}  // namespace
+
+uint64_t serve(VM& vm,
+               std::istream& in,
+               std::ostream& out,
+               const std::function<void()>& stop_input)
+{
+    // The reader thread would otherwise flush the output concurrently with the writer thread.
+    auto* const tied = in.tie(nullptr);
+
+    Channel<Request> requests;
+    Channel<bytes> responses;
+
+    std::exception_ptr reader_error;
+    std::thread reader{[&] {
+        try
+        {
+            while (auto req = read_request(in))
+            {
+                if (!requests.push(std::move(*req)))
+                    break;
+            }
+        }
+        catch (...)
+        {
+            reader_error = std::current_exception();
+        }
+        requests.close();
+    }};
+
+    std::thread writer{[&] {
+        while (const auto response = responses.pop())
+        {
+            out.write(reinterpret_cast<const char*>(response->data()),
+                      static_cast<std::streamsize>(response->size()));
+            if (responses.empty())  // Flush only when there are no more responses ready.
+                out.flush();
+        }
+        out.flush();
+    }};
+
+    uint64_t num_requests = 0;
+    std::exception_ptr executor_error;
+    try
+    {
+        StateCache states;
+        while (const auto req = requests.pop())
+        {
+            responses.push(execute(vm, states, *req));
+            ++num_requests;
+        }
+    }
+    catch (...)
+    {
+        // Stop the reader, at the latest at the next request if the input cannot be stopped.
+        // The threads must be joined before rethrowing.
+        executor_error = std::current_exception();
+        requests.close();
+        if (stop_input)
+            stop_input();
+    }
+    responses.close();
+    writer.join();
+    reader.join();
+    in.tie(tied);
+
+    if (executor_error)
+        std::rethrow_exception(executor_error);
+    if (reader_error)
+        std::rethrow_exception(reader_error);
+    return num_requests;
+}
+
+#ifdef EVMC_TOOLING_UNIX_SOCKETS
+void serve_unix_socket(VM& vm, const std::string& path, uint64_t num_connections)
+{
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path))
+        throw std::invalid_argument{"socket path too long: " + path};
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    const FileDescriptor sock{::socket(AF_UNIX, SOCK_STREAM, 0)};
+    if (sock.get() < 0)
+        throw std::system_error{errno, std::system_category(), "socket"};
+    ::unlink(path.c_str());
+    if (::bind(sock.get(), reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0)
+        throw std::system_error{errno, std::system_category(), path};
+    if (::listen(sock.get(), SOMAXCONN) != 0)
+        throw std::system_error{errno, std::system_category(), path};
+
+    for (uint64_t n = 0; num_connections == 0 || n < num_connections;)
+    {
+        const FileDescriptor conn{::accept(sock.get(), nullptr, nullptr)};
+        if (conn.get() < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw std::system_error{errno, std::system_category(), "accept"};
+        }
+        ++n;
+
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+        // Report the closed connection as error instead of raising SIGPIPE (e.g. on macOS).
+        const int nosigpipe = 1;
+        if (::setsockopt(conn.get(), SOL_SOCKET, SO_NOSIGPIPE, &nosigpipe, sizeof(nosigpipe)) != 0)
+            throw std::system_error{errno, std::system_category(), "setsockopt"};
+#endif
+
+        SocketStreamBuf in_buf{conn.get()};
+        SocketStreamBuf out_buf{conn.get()};
+        std::istream in{&in_buf};
+        std::ostream out{&out_buf};
+        try
+        {
+            serve(vm, in, out, [&conn] { ::shutdown(conn.get(), SHUT_RD); });
+        }
+        catch (const std::invalid_argument&)
+        {
+            // The malformed request ends the connection but not the server.
+        }
+    }
+    ::unlink(path.c_str());
+}
+#else
+void serve_unix_socket(VM& /*vm*/, const std::string& /*path*/, uint64_t /*num_connections*/)
+{
+    throw std::system_error{std::make_error_code(std::errc::function_not_supported),
+                            "Unix domain sockets"};
+}
+#endif
+}  // namespace evmc::tooling
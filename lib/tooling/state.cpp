@@ -0,0 +1,250 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "json.hpp"
+#include "le.hpp"
+#include <evmc/hex.hpp>
+#include <evmc/tooling.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+namespace evmc::tooling
+{
+namespace
+{
+/// The snapshot header: the magic and the format version.
+constexpr uint8_t header[] = {'E', 'V', 'M', 'C', 'S', 'T', 'A', 1};
+
+/// The size of the fixed-size part of the account record:
+/// the address, the nonce, the balance, the code hash, the code size and the number of slots.
+constexpr size_t account_record_size = 20 + 8 + 32 + 32 + 8 + 8;
+
+/// The size of the storage slot record: the key and the value.
+constexpr size_t slot_record_size = 32 + 32;
+
+[[noreturn]] void throw_invalid_snapshot(const char* reason)
+{
+    throw std::invalid_argument{std::string{"invalid state snapshot: "} + reason};
+}
+
+/// Decodes the hex string of the JSON state into the fixed-size type (left-padded with zeros).
+template <typename T>
+T parse_hex(const json::Value& value, const std::string& name)
+{
+    const auto* s = value.get<std::string>();
+    std::optional<T> r;
+    if (s != nullptr)
+        r = from_hex<T>(*s);
+    if (!r)
+        throw std::invalid_argument{"invalid JSON state: invalid " + name};
+    return *r;
+}
+
+/// Decodes the JSON number or the hex string of the JSON state into the integer.
+uint64_t parse_uint64(const json::Value& value, const std::string& name)
+{
+    if (const auto* d = value.get<double>(); d != nullptr)
+    {
+        if (*d < 0 || *d > static_cast<double>(std::numeric_limits<int64_t>::max()) ||
+            std::floor(*d) != *d)
+            throw std::invalid_argument{"invalid JSON state: invalid " + name};
+        return static_cast<uint64_t>(*d);
+    }
+    const auto v = parse_hex<bytes32>(value, name);
+    uint64_t r = 0;
+    for (size_t i = 0; i < sizeof(v.bytes); ++i)
+    {
+        if (i < sizeof(v.bytes) - sizeof(r) && v.bytes[i] != 0)
+            throw std::invalid_argument{"invalid JSON state: " + name + " out of range"};
+        r = (r << 8) | v.bytes[i];
+    }
+    return r;
+}
+}  // namespace
+
+State load_state_snapshot(bytes_view snapshot)
+{
+    if (snapshot.size() < sizeof(header) + 8 ||
+        std::memcmp(snapshot.data(), header, sizeof(header)) != 0)
+        throw_invalid_snapshot("invalid header");
+    const auto* p = snapshot.data() + sizeof(header);
+    const auto* const end = snapshot.data() + snapshot.size();
+
+    const auto num_accounts = le::load<uint64_t>(p);
+    p += 8;
+    if (num_accounts > static_cast<size_t>(end - p) / account_record_size)
+        throw_invalid_snapshot("truncated");
+
+    // Reserve the hash tables up front to avoid rehashing during the bulk insert.
+    State state;
+    state.reserve(static_cast<size_t>(num_accounts));
+    for (uint64_t i = 0; i < num_accounts; ++i)
+    {
+        if (static_cast<size_t>(end - p) < account_record_size)
+            throw_invalid_snapshot("truncated");
+
+        address addr;
+        std::memcpy(addr.bytes, p, sizeof(addr.bytes));
+        p += sizeof(addr.bytes);
+        const auto [it, inserted] = state.try_emplace(addr);
+        if (!inserted)
+            throw_invalid_snapshot("duplicate account");
+        auto& account = it->second;
+        const auto nonce = le::load<uint64_t>(p);
+        p += 8;
+        if (nonce > static_cast<uint64_t>(std::numeric_limits<int>::max()))
+            throw_invalid_snapshot("nonce out of range");
+        account.nonce = static_cast<int>(nonce);
+        std::memcpy(account.balance.bytes, p, sizeof(account.balance.bytes));
+        p += sizeof(account.balance.bytes);
+        std::memcpy(account.codehash.bytes, p, sizeof(account.codehash.bytes));
+        p += sizeof(account.codehash.bytes);
+        const auto code_size = le::load<uint64_t>(p);
+        const auto account_slots = le::load<uint64_t>(p + 8);
+        p += 16;
+
+        const auto remaining = static_cast<size_t>(end - p);
+        if (code_size > remaining ||
+            account_slots > (remaining - static_cast<size_t>(code_size)) / slot_record_size)
+            throw_invalid_snapshot("truncated");
+
+        account.code.assign(p, static_cast<size_t>(code_size));
+        p += code_size;
+
+        account.storage.reserve(static_cast<size_t>(account_slots));
+        for (uint64_t k = 0; k < account_slots; ++k)
+        {
+            bytes32 key;
+            bytes32 value;
+            std::memcpy(key.bytes, p, sizeof(key.bytes));
+            std::memcpy(value.bytes, p + sizeof(key.bytes), sizeof(value.bytes));
+            p += slot_record_size;
+            if (!account.storage.try_emplace(key, value).second)
+                throw_invalid_snapshot("duplicate storage slot");
+        }
+    }
+    if (p != end)
+        throw_invalid_snapshot("unexpected trailing data");
+    return state;
+}
+
+void write_state_snapshot(std::ostream& out, const State& state)
+{
+    std::vector<const State::value_type*> accounts;
+    accounts.reserve(state.size());
+    for (const auto& entry : state)
+        accounts.push_back(&entry);
+    std::sort(accounts.begin(), accounts.end(),
+              [](const auto* a, const auto* b) { return a->first < b->first; });
+
+    bytes buffer{header, sizeof(header)};
+    le::put<uint64_t>(buffer, accounts.size());
+
+    std::vector<std::pair<bytes32, bytes32>> slots;
+    for (const auto* entry : accounts)
+    {
+        const auto& [addr, account] = *entry;
+        buffer.append(addr.bytes, sizeof(addr.bytes));
+        le::put(buffer, static_cast<uint64_t>(account.nonce));
+        buffer.append(account.balance.bytes, sizeof(account.balance.bytes));
+        buffer.append(account.codehash.bytes, sizeof(account.codehash.bytes));
+        le::put<uint64_t>(buffer, account.code.size());
+        le::put<uint64_t>(buffer, account.storage.size());
+        buffer.append(account.code);
+
+        slots.clear();
+        for (const auto& [key, value] : account.storage)
+            slots.emplace_back(key, value.current);
+        std::sort(slots.begin(), slots.end());
+        for (const auto& [key, value] : slots)
+        {
+            buffer.append(key.bytes, sizeof(key.bytes));
+            buffer.append(value.bytes, sizeof(value.bytes));
+        }
+
+        // Flush the buffer periodically to bound the memory usage.
+        if (buffer.size() >= (size_t{1} << 20))
+        {
+            out.write(reinterpret_cast<const char*>(buffer.data()),
+                      static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    out.write(reinterpret_cast<const char*>(buffer.data()),
+              static_cast<std::streamsize>(buffer.size()));
+}
+
+State parse_json_state(std::string_view text)
+{
+    const auto doc = json::parse(text);
+    const auto* accounts = doc.get<json::Object>();
+    if (accounts == nullptr)
+        throw std::invalid_argument{"invalid JSON state: expected object of accounts"};
+
+    State state;
+    state.reserve(accounts->size());
+    for (const auto& [addr_hex, fields] : *accounts)
+    {
+        const auto addr = from_hex<address>(addr_hex);
+        if (!addr)
+            throw std::invalid_argument{"invalid JSON state: invalid address " + addr_hex};
+        if (fields.get<json::Object>() == nullptr)
+            throw std::invalid_argument{"invalid JSON state: invalid account " + addr_hex};
+
+        auto& account = state[*addr];
+        if (const auto* v = fields.find("nonce"); v != nullptr)
+        {
+            const auto nonce = parse_uint64(*v, "nonce");
+            if (nonce > static_cast<uint64_t>(std::numeric_limits<int>::max()))
+                throw std::invalid_argument{"invalid JSON state: nonce out of range"};
+            account.nonce = static_cast<int>(nonce);
+        }
+        if (const auto* v = fields.find("balance"); v != nullptr)
+        {
+            if (v->get<double>() != nullptr)
+                account.set_balance(parse_uint64(*v, "balance"));
+            else
+                account.balance = parse_hex<uint256be>(*v, "balance");
+        }
+        if (const auto* v = fields.find("code"); v != nullptr)
+        {
+            const auto* s = v->get<std::string>();
+            auto code = s != nullptr ? from_hex(*s) : std::nullopt;
+            if (!code)
+                throw std::invalid_argument{"invalid JSON state: invalid code"};
+            account.set_code(std::move(*code));
+        }
+        if (const auto* v = fields.find("codehash"); v != nullptr)
+            account.codehash = parse_hex<bytes32>(*v, "codehash");
+        if (const auto* v = fields.find("storage"); v != nullptr)
+        {
+            const auto* storage = v->get<json::Object>();
+            if (storage == nullptr)
+                throw std::invalid_argument{"invalid JSON state: invalid storage"};
+            account.storage.reserve(storage->size());
+            for (const auto& [key_hex, value] : *storage)
+            {
+                const auto key = from_hex<bytes32>(key_hex);
+                if (!key)
+                    throw std::invalid_argument{"invalid JSON state: invalid storage key"};
+                account.storage.emplace(*key, parse_hex<bytes32>(value, "storage value"));
+            }
+        }
+    }
+    return state;
+}
+
+State load_state(const std::string& path)
+{
+    const MappedFile file{path};
+    const auto data = file.data();
+    if (data.size() >= sizeof(header) && std::memcmp(data.data(), header, sizeof(header)) == 0)
+        return load_state_snapshot(data);
+    return parse_json_state({reinterpret_cast<const char*>(data.data()), data.size()});
+}
+}  // namespace evmc::tooling
@@ -0,0 +1,70 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+#pragma once
+
+#include <evmc/evmc.hpp>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace evmc::bench
+{
+/// The distribution of the generated keys.
+///
+/// The distributions mimic the keys seen by a Host during the block execution.
+enum class KeyDistribution : int
+{
+    /// Uniformly random keys, like account addresses and mapping storage keys (Keccak hashes).
+    hashed,
+
+    /// Small integers, like storage slots of the contract state variables.
+    sequential,
+
+    /// Keys sharing the same long prefix and differing only in the last byte,
+    /// like precompile addresses and adjacent array elements.
+    shared_prefix,
+};
+
+/// The names of the key distributions, indexed by the KeyDistribution value.
+inline constexpr const char* key_distribution_names[] = {"hashed", "sequential", "shared_prefix"};
+
+/// The number of the key distributions.
+inline constexpr int num_key_distributions = static_cast<int>(std::size(key_distribution_names));
+
+/// Generates the key of the given distribution. T is evmc::address or evmc::bytes32.
+template <typename T>
+T make_key(KeyDistribution distribution, uint64_t i, std::mt19937_64& rng) noexcept
+{
+    T key{};
+    switch (distribution)
+    {
+    case KeyDistribution::hashed:
+        for (auto& b : key.bytes)
+            b = static_cast<uint8_t>(rng());
+        break;
+    case KeyDistribution::sequential:
+        for (size_t k = 0; k < 8; ++k)
+            key.bytes[sizeof(key) - 1 - k] = static_cast<uint8_t>(i >> (8 * k));
+        break;
+    case KeyDistribution::shared_prefix:
+        for (size_t k = 0; k < sizeof(key) - 1; ++k)
+            key.bytes[k] = 0xa5;
+        key.bytes[sizeof(key) - 1] = static_cast<uint8_t>(i);
+        break;
+    }
+    return key;
+}
+
+/// Generates the number of keys of the given distribution using the fixed seed.
+template <typename T>
+std::vector<T> make_keys(KeyDistribution distribution, size_t n)
+{
+    std::mt19937_64 rng{n};
+    std::vector<T> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+        keys.push_back(make_key<T>(distribution, i, rng));
+    return keys;
+}
+}  // namespace evmc::bench
@@ -0,0 +1,85 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <benchmark/benchmark.h>
+#include <evmc/bytes.hpp>
+
+namespace
+{
+/// Creates the bytes of the size given by the benchmark's first argument
+/// filled with the non-zero pattern.
+evmc::bytes make_bytes(benchmark::State& state)
+{
+    evmc::bytes bs(static_cast<size_t>(state.range(0)), 0);
+    for (size_t i = 0; i < bs.size(); ++i)
+        bs[i] = static_cast<uint8_t>(i % 251 + 1);
+    return bs;
+}
+
+/// Compares the bytes with the copy differing only in the last byte (@p Equal = false),
+/// i.e. the whole buffer must be scanned in both cases.
+template <bool Equal>
+void equal(benchmark::State& state)
+{
+    const auto a = make_bytes(state);
+    auto b = a;
+    if (!Equal && !b.empty())
+        ++b.back();
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(evmc::bytes_view{a} == evmc::bytes_view{b});
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+/// Orders the bytes differing only in the last byte.
+void compare(benchmark::State& state)
+{
+    const auto a = make_bytes(state);
+    auto b = a;
+    if (!b.empty())
+        ++b.back();
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(evmc::bytes_view{a}.compare(b));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+/// Searches for the absent byte value, e.g. the scan for an opcode in the code.
+void find(benchmark::State& state)
+{
+    const auto bs = make_bytes(state);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(evmc::bytes_view{bs}.find(uint8_t{0x00}));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+/// Copies the bytes into the preallocated buffer.
+void copy(benchmark::State& state)
+{
+    const auto src = make_bytes(state);
+    evmc::bytes dst;
+    dst.reserve(src.size());
+    for ([[maybe_unused]] auto _ : state)
+    {
+        dst.assign(src);
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// The sizes of: the word, the typical call input and the maximum contract code (EIP-170).
+BENCHMARK_TEMPLATE(equal, true)->Arg(32)->Arg(132)->Arg(24576);
+BENCHMARK_TEMPLATE(equal, false)->Arg(32)->Arg(132)->Arg(24576);
+BENCHMARK(compare)->Arg(32)->Arg(132)->Arg(24576);
+BENCHMARK(find)->Arg(32)->Arg(132)->Arg(24576);
+BENCHMARK(copy)->Arg(32)->Arg(132)->Arg(24576);
+}  // namespace
@@ -0,0 +1,177 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "bench_helpers.hpp"
+#include <benchmark/benchmark.h>
+#include <evmc/flat_map.hpp>
+#include <algorithm>
+#include <unordered_map>
+
+namespace
+{
+using evmc::bench::key_distribution_names;
+using evmc::bench::KeyDistribution;
+using evmc::bench::make_keys;
+using evmc::bench::num_key_distributions;
+
+/// The number of keys used by the benchmarks of the key operations.
+constexpr size_t num_keys = 1024;
+
+/// Returns the key distribution from the benchmark's first argument and labels the benchmark.
+KeyDistribution key_distribution(benchmark::State& state)
+{
+    const auto d = state.range(0);
+    state.SetLabel(key_distribution_names[d]);
+    return static_cast<KeyDistribution>(d);
+}
+
+/// Hashes the keys. Also reports the collisions of the hash values in the power-of-two
+/// hash table of the size equal to the number of keys (i.e. indexed by the low bits):
+/// for the random hash values the expected ratio of the colliding keys is 1/e ~ 0.37.
+template <typename T, typename Hash = std::hash<T>>
+void hash(benchmark::State& state)
+{
+    const auto keys = make_keys<T>(key_distribution(state), num_keys);
+    const Hash h;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto& key : keys)
+            benchmark::DoNotOptimize(h(key));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+
+    std::vector<bool> buckets(keys.size());
+    size_t num_collisions = 0;
+    for (const auto& key : keys)
+    {
+        const auto bucket = h(key) & (keys.size() - 1);
+        num_collisions += buckets[bucket];
+        buckets[bucket] = true;
+    }
+    state.counters["collisions"] =
+        static_cast<double>(num_collisions) / static_cast<double>(keys.size());
+}
+
+/// Compares every key with its copy (@p Equal) or with the next key.
+/// The distribution decides how long the common prefix of the different keys is.
+template <typename T, bool Equal>
+void equal(benchmark::State& state)
+{
+    const auto keys = make_keys<T>(key_distribution(state), num_keys);
+    auto others = keys;
+    if (!Equal)
+        std::rotate(others.begin(), others.begin() + 1, others.end());
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (size_t i = 0; i < keys.size(); ++i)
+            benchmark::DoNotOptimize(keys[i] == others[i]);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+/// Sorts the keys, i.e. mostly measures operator<.
+template <typename T>
+void sort(benchmark::State& state)
+{
+    const auto keys = make_keys<T>(key_distribution(state), num_keys);
+    auto sorted = keys;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        state.PauseTiming();
+        sorted = keys;
+        state.ResumeTiming();
+        std::sort(sorted.begin(), sorted.end());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+/// Checks keys of which one in 8 is zero, like the storage values read by a contract.
+template <typename T>
+void is_zero(benchmark::State& state)
+{
+    auto keys = make_keys<T>(key_distribution(state), num_keys);
+    for (size_t i = 0; i < keys.size(); i += 8)
+        keys[i] = {};
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto& key : keys)
+            benchmark::DoNotOptimize(evmc::is_zero(key));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+/// Looks up the keys in the hash map (by default std::unordered_map), half of them present.
+/// This is how the MockedHost finds accounts and storage slots.
+template <typename T, typename Hash = std::hash<T>, typename Map = std::unordered_map<T, int, Hash>>
+void map_find(benchmark::State& state)
+{
+    const auto keys = make_keys<T>(key_distribution(state), 2 * num_keys);
+    Map map;
+    for (size_t i = 0; i < keys.size(); i += 2)
+        map.emplace(keys[i], 0);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto& key : keys)
+            benchmark::DoNotOptimize(map.find(key));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+/// The flat_map from the keys to int, for map_find.
+template <typename T>
+using flat_map = evmc::flat_map<T, int, evmc::fast_hash>;
+
+/// Creates the evmc::Result with the output of the size, moves it and releases it.
+void result_move(benchmark::State& state)
+{
+    const std::vector<uint8_t> output(static_cast<size_t>(state.range(0)), 0xfe);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        evmc::Result result{EVMC_SUCCESS, 100, 0, output.data(), output.size()};
+        evmc::Result moved{std::move(result)};
+        benchmark::DoNotOptimize(moved.output_data);
+    }
+}
+
+/// Creates the evmc::Result and passes it through the C API like Host::call() does.
+void result_release_raw(benchmark::State& state)
+{
+    const std::vector<uint8_t> output(static_cast<size_t>(state.range(0)), 0xfe);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        evmc::Result result{EVMC_SUCCESS, 100, 0, output.data(), output.size()};
+        const auto raw = result.release_raw();
+        benchmark::DoNotOptimize(raw.output_data);
+        evmc::Result back{raw};
+    }
+}
+
+#define KEY_BENCHMARK(...) \
+    BENCHMARK_TEMPLATE(__VA_ARGS__)->DenseRange(0, num_key_distributions - 1)
+
+KEY_BENCHMARK(hash, evmc::address);
+KEY_BENCHMARK(hash, evmc::address, evmc::fast_hash);
+KEY_BENCHMARK(hash, evmc::address, evmc::prehashed_hash);
+KEY_BENCHMARK(hash, evmc::bytes32);
+KEY_BENCHMARK(hash, evmc::bytes32, evmc::fast_hash);
+KEY_BENCHMARK(hash, evmc::bytes32, evmc::prehashed_hash);
+KEY_BENCHMARK(equal, evmc::address, true);
+KEY_BENCHMARK(equal, evmc::address, false);
+KEY_BENCHMARK(equal, evmc::bytes32, true);
+KEY_BENCHMARK(equal, evmc::bytes32, false);
+KEY_BENCHMARK(sort, evmc::address);
+KEY_BENCHMARK(sort, evmc::bytes32);
+KEY_BENCHMARK(is_zero, evmc::address);
+KEY_BENCHMARK(is_zero, evmc::bytes32);
+KEY_BENCHMARK(map_find, evmc::address);
+KEY_BENCHMARK(map_find, evmc::address, evmc::fast_hash);
+KEY_BENCHMARK(map_find, evmc::bytes32);
+KEY_BENCHMARK(map_find, evmc::bytes32, evmc::fast_hash);
+KEY_BENCHMARK(map_find, evmc::bytes32, evmc::prehashed_hash);
+KEY_BENCHMARK(map_find, evmc::address, evmc::fast_hash, flat_map<evmc::address>);
+KEY_BENCHMARK(map_find, evmc::bytes32, evmc::fast_hash, flat_map<evmc::bytes32>);
+BENCHMARK(result_move)->Arg(0)->Arg(32)->Arg(1024);
+BENCHMARK(result_release_raw)->Arg(0)->Arg(32)->Arg(1024);
+}  // namespace
@@ -0,0 +1,56 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <benchmark/benchmark.h>
+#include <evmc/evmc.hpp>
+#include <evmc/hex.hpp>
+#include <random>
+
+namespace
+{
+/// Generates the random bytes of the size given by the benchmark's first argument.
+evmc::bytes random_bytes(benchmark::State& state)
+{
+    std::mt19937_64 rng{0};
+    evmc::bytes bs(static_cast<size_t>(state.range(0)), 0);
+    for (auto& b : bs)
+        b = static_cast<uint8_t>(rng());
+    return bs;
+}
+
+void hex(benchmark::State& state)
+{
+    const auto bs = random_bytes(state);
+    for ([[maybe_unused]] auto _ : state)
+        benchmark::DoNotOptimize(evmc::hex(bs));
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void from_hex(benchmark::State& state)
+{
+    const auto str = "0x" + evmc::hex(random_bytes(state));
+    for ([[maybe_unused]] auto _ : state)
+        benchmark::DoNotOptimize(evmc::from_hex(str));
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+/// Decodes the fixed-size type, as done by the evmc::literals.
+template <typename T>
+void from_hex_fixed(benchmark::State& state)
+{
+    T value{};
+    for (auto& b : value.bytes)
+        b = static_cast<uint8_t>(&b - value.bytes + 0x51);
+    const auto str = evmc::hex({value.bytes, sizeof(value.bytes)});
+    for ([[maybe_unused]] auto _ : state)
+        benchmark::DoNotOptimize(evmc::from_hex<T>(str));
+    state.SetBytesProcessed(state.iterations() * int64_t{sizeof(value)});
+}
+
+// The sizes of: the address, the word, the typical call input and the typical contract code.
+BENCHMARK(hex)->Arg(20)->Arg(32)->Arg(132)->Arg(24576);
+BENCHMARK(from_hex)->Arg(20)->Arg(32)->Arg(132)->Arg(24576);
+BENCHMARK_TEMPLATE(from_hex_fixed, evmc::address);
+BENCHMARK_TEMPLATE(from_hex_fixed, evmc::bytes32);
+}  // namespace
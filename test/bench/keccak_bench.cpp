@@ -0,0 +1,37 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <benchmark/benchmark.h>
+#include <evmc/keccak.hpp>
+#include <vector>
+
+namespace
+{
+void keccak256(benchmark::State& state)
+{
+    const evmc::bytes data(static_cast<size_t>(state.range(0)), 0xfe);
+    for ([[maybe_unused]] auto _ : state)
+        benchmark::DoNotOptimize(evmc::keccak256(data));
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+/// Hashes the batch of the number of inputs given by the benchmark's second argument.
+void keccak256_multi(benchmark::State& state)
+{
+    const auto n = static_cast<size_t>(state.range(1));
+    const evmc::bytes data(static_cast<size_t>(state.range(0)), 0xfe);
+    const std::vector<evmc::bytes_view> inputs(n, data);
+    std::vector<evmc::bytes32> outputs(n);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        evmc::keccak256(inputs.data(), outputs.data(), n);
+        benchmark::DoNotOptimize(outputs.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+
+BENCHMARK(keccak256)->Arg(32)->Arg(136)->Arg(1024);
+BENCHMARK(keccak256_multi)->ArgsProduct({{32, 136, 1024}, {4, 8}});
+}  // namespace
@@ -0,0 +1,154 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include "bench_helpers.hpp"
+#include <benchmark/benchmark.h>
+#include <evmc/mocked_host.hpp>
+
+namespace
+{
+using evmc::bench::key_distribution_names;
+using evmc::bench::KeyDistribution;
+using evmc::bench::make_keys;
+using evmc::bench::num_key_distributions;
+using namespace evmc::literals;
+
+/// The number of storage slots accessed in a single benchmark iteration.
+constexpr size_t num_slots = 256;
+
+constexpr auto account = 0x00000000000000000000000000000000000000c0_address;
+
+/// Returns the storage keys of the distribution given by the benchmark's first argument.
+std::vector<evmc::bytes32> storage_keys(benchmark::State& state)
+{
+    const auto d = state.range(0);
+    state.SetLabel(key_distribution_names[d]);
+    return make_keys<evmc::bytes32>(static_cast<KeyDistribution>(d), num_slots);
+}
+
+/// Sets the new storage slots of an account, i.e. the cost includes the storage map growth.
+void set_storage_new(benchmark::State& state)
+{
+    const auto keys = storage_keys(state);
+    const auto value = 0x01_bytes32;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        state.PauseTiming();
+        evmc::MockedHost host;
+        state.ResumeTiming();
+        for (const auto& key : keys)
+            benchmark::DoNotOptimize(host.set_storage(account, key, value));
+        state.PauseTiming();
+        host = {};  // Destroy the state outside of the measurement.
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+/// Modifies the existing storage slots, optionally with the journal enabled by a checkpoint.
+template <bool Journaling>
+void set_storage_existing(benchmark::State& state)
+{
+    const auto keys = storage_keys(state);
+    evmc::MockedHost host;
+    for (const auto& key : keys)
+        host.accounts[account].storage[key] = {0x01_bytes32};
+    const auto checkpoint = Journaling ? host.checkpoint() : 0;
+
+    auto value = 0x02_bytes32;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto& key : keys)
+            benchmark::DoNotOptimize(host.set_storage(account, key, value));
+        ++value.bytes[31];
+        if (Journaling)
+        {
+            state.PauseTiming();
+            host.revert(checkpoint);  // Keep the journal from growing.
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+/// Reads the storage slots, half of them present.
+template <typename Host>
+void get_storage(benchmark::State& state)
+{
+    const auto keys = storage_keys(state);
+    Host host;
+    for (size_t i = 0; i < keys.size(); i += 2)
+        host.accounts[account].storage[keys[i]] = {0x01_bytes32};
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto& key : keys)
+            benchmark::DoNotOptimize(host.get_storage(account, key));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+/// Reads the random storage slots of an account having the storage of the size given
+/// by the benchmark's first argument, i.e. the cost includes the cache misses.
+template <typename Host>
+void get_storage_large(benchmark::State& state)
+{
+    const auto keys = make_keys<evmc::bytes32>(KeyDistribution::hashed,
+                                               static_cast<size_t>(state.range(0)));
+    Host host;
+    auto& storage = host.accounts[account].storage;
+    storage.reserve(keys.size());
+    for (const auto& key : keys)
+        storage.emplace(key, 0x01_bytes32);
+
+    size_t i = 0;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (size_t j = 0; j < num_slots; ++j)
+        {
+            benchmark::DoNotOptimize(host.get_storage(account, keys[i]));
+            i = (i + 7919) % keys.size();  // Step by a prime to visit all the keys.
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * int64_t{num_slots});
+}
+
+/// Modifies the storage slots of an account with a large storage and commits the transaction.
+/// The commit cost depends only on the number of the modified slots.
+void commit_transaction(benchmark::State& state)
+{
+    const auto keys = storage_keys(state);
+    evmc::MockedHost host;
+    auto& storage = host.accounts[account].storage;
+    for (const auto& key : make_keys<evmc::bytes32>(KeyDistribution::hashed, 64 * num_slots))
+        storage[key] = {0x01_bytes32};
+    for (const auto& key : keys)
+        storage[key] = {0x01_bytes32};
+
+    auto value = 0x02_bytes32;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto& key : keys)
+        {
+            host.access_storage(account, key);
+            host.set_storage(account, key, value);
+        }
+        host.commit_transaction();
+        ++value.bytes[31];
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+BENCHMARK(set_storage_new)->DenseRange(0, num_key_distributions - 1);
+BENCHMARK_TEMPLATE(set_storage_existing, false)->DenseRange(0, num_key_distributions - 1);
+BENCHMARK_TEMPLATE(set_storage_existing, true)->DenseRange(0, num_key_distributions - 1);
+BENCHMARK_TEMPLATE(get_storage, evmc::MockedHost)->DenseRange(0, num_key_distributions - 1);
+BENCHMARK_TEMPLATE(get_storage, evmc::BasicMockedHost<evmc::StdMapPolicy>)
+    ->DenseRange(0, num_key_distributions - 1);
+BENCHMARK_TEMPLATE(get_storage_large, evmc::MockedHost)->Arg(1 << 16)->Arg(1 << 22);
+BENCHMARK_TEMPLATE(get_storage_large, evmc::BasicMockedHost<evmc::StdMapPolicy>)
+    ->Arg(1 << 16)
+    ->Arg(1 << 22);
+BENCHMARK(commit_transaction)->DenseRange(0, num_key_distributions - 1);
+}  // namespace
@@ -7,20 +7,28 @@
 #include <evmc/evmc.h>
 #include <evmc/evmc.hpp>
 #include <evmc/filter_iterator.hpp>
+#include <evmc/flat_map.hpp>
 #include <evmc/helpers.h>
 #include <evmc/hex.hpp>
 #include <evmc/instructions.h>
+#include <evmc/keccak.hpp>
 #include <evmc/loader.h>
 #include <evmc/mocked_host.hpp>
+#include <evmc/platform.hpp>
+#include <evmc/uint256.hpp>
 #include <evmc/utils.h>
 
 // Include again to check if headers have proper include guards.
 #include <evmc/evmc.h>               //NOLINT(readability-duplicate-include)
 #include <evmc/evmc.hpp>             //NOLINT(readability-duplicate-include)
 #include <evmc/filter_iterator.hpp>  //NOLINT(readability-duplicate-include)
+#include <evmc/flat_map.hpp>         //NOLINT(readability-duplicate-include)
 #include <evmc/helpers.h>            //NOLINT(readability-duplicate-include)
 #include <evmc/hex.hpp>              //NOLINT(readability-duplicate-include)
 #include <evmc/instructions.h>       //NOLINT(readability-duplicate-include)
+#include <evmc/keccak.hpp>           //NOLINT(readability-duplicate-include)
 #include <evmc/loader.h>             //NOLINT(readability-duplicate-include)
 #include <evmc/mocked_host.hpp>      //NOLINT(readability-duplicate-include)
+#include <evmc/platform.hpp>         //NOLINT(readability-duplicate-include)
+#include <evmc/uint256.hpp>          //NOLINT(readability-duplicate-include)
 #include <evmc/utils.h>              //NOLINT(readability-duplicate-include)
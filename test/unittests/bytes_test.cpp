@@ -0,0 +1,112 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <evmc/bytes.hpp>
+#include <gtest/gtest.h>
+
+using evmc::bytes;
+using evmc::bytes_view;
+
+namespace
+{
+using traits = evmc::byte_traits<unsigned char>;
+
+constexpr bool constexpr_move_overlapping()
+{
+    unsigned char bs[] = {1, 2, 3, 4, 5};
+    traits::move(bs + 1, bs, 3);
+    traits::move(bs, bs + 2, 3);
+    return bs[0] == 2 && bs[1] == 3 && bs[2] == 5 && bs[3] == 3 && bs[4] == 5;
+}
+
+constexpr bool constexpr_copy_and_assign()
+{
+    unsigned char bs[4]{};
+    constexpr unsigned char src[] = {0xa0, 0xb0};
+    traits::assign(bs, 4, 0xff);
+    traits::copy(bs + 1, src, 2);
+    return bs[0] == 0xff && bs[1] == 0xa0 && bs[2] == 0xb0 && bs[3] == 0xff;
+}
+}  // namespace
+
+TEST(bytes, constexpr_operations)
+{
+    constexpr unsigned char a[] = {0x01, 0x80, 0x03};
+    constexpr unsigned char b[] = {0x01, 0x7f, 0x03};
+    static_assert(traits::compare(a, a, 3) == 0);
+    static_assert(traits::compare(a, b, 3) > 0);
+    static_assert(traits::compare(b, a, 3) < 0);
+    static_assert(traits::compare(a, b, 1) == 0);
+    static_assert(traits::compare(a, b, 0) == 0);
+    static_assert(traits::find(a, 3, 0x03) == &a[2]);
+    static_assert(traits::find(a, 2, 0x03) == nullptr);
+    static_assert(traits::find(a, 0, 0x01) == nullptr);
+    static_assert(bytes_view{a, 3} == bytes_view{a, 3});
+    static_assert(bytes_view{a, 3} != bytes_view{b, 3});
+    static_assert(bytes_view{a, 2} < bytes_view{a, 3});
+    static_assert(bytes_view{b, 3} < bytes_view{a, 3});
+    static_assert(constexpr_move_overlapping());
+    static_assert(constexpr_copy_and_assign());
+}
+
+TEST(bytes, compare)
+{
+    // The bytes above 0x7f must compare as unsigned.
+    const bytes a{0x01, 0x80, 0x03};
+    const bytes b{0x01, 0x7f, 0x03};
+    EXPECT_EQ(a.compare(a), 0);
+    EXPECT_GT(a.compare(b), 0);
+    EXPECT_LT(b.compare(a), 0);
+    EXPECT_LT(bytes_view{a}.substr(0, 2), bytes_view{a});
+    EXPECT_EQ(bytes_view{}.compare(bytes_view{}), 0);
+    EXPECT_EQ(traits::compare(nullptr, nullptr, 0), 0);
+}
+
+TEST(bytes, compare_long)
+{
+    // The difference in every position of the buffer longer than the vector sizes.
+    const bytes a(1000, 0xee);
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        auto b = a;
+        b[i] = 0xef;
+        EXPECT_LT(a, b) << i;
+        EXPECT_NE(a, b) << i;
+        EXPECT_EQ(bytes_view{a}.substr(0, i), bytes_view{b}.substr(0, i));
+    }
+}
+
+TEST(bytes, find)
+{
+    bytes bs(100, 0x00);
+    bs[70] = 0xfe;
+    bs[90] = 0xfe;
+    EXPECT_EQ(bs.find(uint8_t{0xfe}), 70);
+    EXPECT_EQ(bs.find(uint8_t{0xfe}, 71), 90);
+    EXPECT_EQ(bs.find(uint8_t{0xfe}, 91), bytes::npos);
+    EXPECT_EQ(bs.find(uint8_t{0xfd}), bytes::npos);
+    EXPECT_EQ(bytes_view{bs}.find(bytes_view{bs}.substr(69, 2)), 69);
+    EXPECT_EQ(bytes_view{}.find(uint8_t{0x00}), bytes_view::npos);
+    EXPECT_EQ(traits::find(nullptr, 0, 0x00), nullptr);
+}
+
+TEST(bytes, copy_and_move)
+{
+    bytes bs{1, 2, 3, 4, 5};
+    bs.replace(1, 3, bs, 0, 3);  // Overlapping ranges.
+    EXPECT_EQ(bs, (bytes{1, 1, 2, 3, 5}));
+    bs.erase(0, 2);
+    EXPECT_EQ(bs, (bytes{2, 3, 5}));
+    bs.insert(0, 2, 0xcc);
+    EXPECT_EQ(bs, (bytes{0xcc, 0xcc, 2, 3, 5}));
+    bs.append(bs);
+    EXPECT_EQ(bs, (bytes{0xcc, 0xcc, 2, 3, 5, 0xcc, 0xcc, 2, 3, 5}));
+
+    unsigned char buf[3]{};
+    EXPECT_EQ(bytes_view{bs}.copy(buf, 3, 2), 3);
+    EXPECT_EQ((bytes_view{buf, 3}), (bytes{2, 3, 5}));
+    EXPECT_EQ(traits::move(buf, nullptr, 0), buf);
+    EXPECT_EQ(traits::copy(buf, nullptr, 0), buf);
+    EXPECT_EQ(traits::assign(buf, 0, 0x00), buf);
+}
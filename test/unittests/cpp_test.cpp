@@ -13,6 +13,7 @@
 #include <evmc/mocked_host.hpp>
 #include <gtest/gtest.h>
 #include <array>
+#include <bitset>
 #include <cctype>
 #include <cstring>
 #include <map>
@@ -171,6 +172,102 @@ TEST(cpp, std_hash)
     EXPECT_EQ(std::hash<evmc::bytes32>{}(rand_bytes32_2), static_cast<size_t>(0x4efee0983bb6c4f5));
 }
 
+TEST(cpp, fast_hash)
+{
+    using namespace evmc::literals;
+    constexpr evmc::fast_hash h;
+
+    static_assert(h(evmc::address{}) == static_cast<size_t>(0x80ed58f20528ab14));
+    static_assert(h(evmc::bytes32{}) == static_cast<size_t>(0x31e44450d67b0f97));
+    EXPECT_EQ(h(evmc::address{}), static_cast<size_t>(0x80ed58f20528ab14));
+    EXPECT_EQ(h(evmc::bytes32{}), static_cast<size_t>(0x31e44450d67b0f97));
+    EXPECT_EQ(h(0xaa00bb00cc00dd00ee00ff001100220033004400_address),
+              static_cast<size_t>(0x085c6bf7a63bbcec));
+    EXPECT_EQ(h(0xbb01bb02bb03bb04bb05bb06bb07bb08bb09bb0abb0bbb0cbb0dbb0ebb0fbb00_bytes32),
+              static_cast<size_t>(0xe665112ebceb90da));
+
+    // Sequential keys must be spread over the buckets selected by the low bits of the hash.
+    // The number of buckets used by random hashes is about (1 - 1/e) ~ 63% of the keys.
+    constexpr size_t n = 1 << 12;
+    std::vector<bool> buckets(n);
+    size_t num_used_buckets = 0;
+    for (uint64_t i = 0; i < n; ++i)
+    {
+        const auto bucket = h(evmc::bytes32{i}) % n;
+        num_used_buckets += !buckets[bucket];
+        buckets[bucket] = true;
+    }
+    EXPECT_GT(num_used_buckets, n * 6 / 10);
+}
+
+TEST(cpp, fast_hash_avalanche)
+{
+    // Flipping any input bit should flip about half of the output bits.
+    evmc::bytes32 key;
+    for (size_t i = 0; i < sizeof(key); ++i)
+        key.bytes[i] = static_cast<uint8_t>(i * 0x45 + 0x17);
+    evmc::address addr;
+    std::copy_n(key.bytes, sizeof(addr), addr.bytes);
+
+    constexpr evmc::fast_hash h;
+    const auto flipped_bits = [](size_t x, size_t y) {
+        return std::bitset<sizeof(size_t) * 8>{x ^ y}.count();
+    };
+
+    size_t total = 0;
+    for (size_t bit = 0; bit < sizeof(key) * 8; ++bit)
+    {
+        auto k = key;
+        k.bytes[bit / 8] ^= static_cast<uint8_t>(1 << (bit % 8));
+        const auto n = flipped_bits(h(key), h(k));
+        EXPECT_GE(n, 16) << bit;
+        EXPECT_LE(n, 48) << bit;
+        total += n;
+    }
+    for (size_t bit = 0; bit < sizeof(addr) * 8; ++bit)
+    {
+        auto a = addr;
+        a.bytes[bit / 8] ^= static_cast<uint8_t>(1 << (bit % 8));
+        const auto n = flipped_bits(h(addr), h(a));
+        EXPECT_GE(n, 16) << bit;
+        EXPECT_LE(n, 48) << bit;
+        total += n;
+    }
+    const auto average = static_cast<double>(total) / ((sizeof(key) + sizeof(addr)) * 8);
+    EXPECT_GT(average, 30.0);
+    EXPECT_LT(average, 34.0);
+}
+
+TEST(cpp, prehashed_hash)
+{
+    using namespace evmc::literals;
+    constexpr evmc::prehashed_hash h;
+
+    static_assert(h(evmc::address{}) == 0);
+    static_assert(h(evmc::bytes32{5}) == 5);
+    EXPECT_EQ(h(evmc::bytes32{0x0102030405060708}), static_cast<size_t>(0x0102030405060708));
+    EXPECT_EQ(h(0xaa00bb00cc00dd00ee00ff001100220033004400_address),
+              static_cast<size_t>(0x1100220033004400));
+    EXPECT_EQ(h(0xff000000000000000000000000000000000000000000000000000000000000ee_bytes32),
+              static_cast<size_t>(0xee));
+}
+
+TEST(cpp, hash_containers)
+{
+    using namespace evmc::literals;
+    std::unordered_map<evmc::address, int, evmc::fast_hash> accounts;
+    accounts[0x01_address] = 1;
+    accounts[0x02_address] = 2;
+    EXPECT_EQ(accounts.at(0x01_address), 1);
+    EXPECT_EQ(accounts.count(0x03_address), 0);
+
+    std::unordered_map<evmc::bytes32, int, evmc::prehashed_hash> storage;
+    storage[0x01_bytes32] = 1;
+    storage[0x0100000000000000000000000000000000000000000000000000000000000001_bytes32] = 2;
+    EXPECT_EQ(storage.at(0x01_bytes32), 1);
+    EXPECT_EQ(storage.size(), 2);
+}
+
 TEST(cpp, std_maps)
 {
     std::map<evmc::address, bool> addresses;
@@ -350,6 +447,83 @@ TEST(cpp, bytes32_comparison)
     }
 }
 
+TEST(cpp, constexpr_comparison)
+{
+    // The constexpr implementations must match the runtime ones tested above.
+    constexpr auto a1 = 0x0000000000000000000000000000000000000001_address;
+    constexpr auto a2 = 0x0100000000000000000000000000000000000000_address;
+    static_assert(a1 == a1);
+    static_assert(a1 != a2);
+    static_assert(a1 < a2);
+    static_assert(!(a2 < a1));
+    static_assert(!is_zero(a1));
+    static_assert(is_zero(evmc::address{}));
+
+    constexpr auto b1 = 0x00000000000000000000000000000000000000000000000000000000000000ff_bytes32;
+    constexpr auto b2 = 0x0000000000000000000000000000000000000000000000000000000000000100_bytes32;
+    static_assert(b1 == b1);
+    static_assert(b1 != b2);
+    static_assert(b1 < b2);
+    static_assert(!(b2 < b1));
+    static_assert(!is_zero(b1));
+    static_assert(is_zero(evmc::bytes32{}));
+
+    constexpr uint8_t data[]{1, 2, 3, 4, 5, 6, 7, 8};
+    static_assert(evmc::load64be(data) == 0x0102030405060708);
+    static_assert(evmc::load64le(data) == 0x0807060504030201);
+    static_assert(evmc::load32be(data) == 0x01020304);
+    static_assert(evmc::load32le(data) == 0x04030201);
+    EXPECT_EQ(evmc::load64be(data), 0x0102030405060708);
+    EXPECT_EQ(evmc::load64le(data), 0x0807060504030201);
+    EXPECT_EQ(evmc::load32be(data), 0x01020304);
+    EXPECT_EQ(evmc::load32le(data), 0x04030201);
+}
+
+TEST(cpp, is_zero_single_byte)
+{
+    for (size_t i = 0; i < sizeof(evmc::address); ++i)
+    {
+        evmc::address a;
+        a.bytes[i] = 0x80;
+        EXPECT_FALSE(is_zero(a));
+    }
+    for (size_t i = 0; i < sizeof(evmc::bytes32); ++i)
+    {
+        evmc::bytes32 b;
+        b.bytes[i] = 0x80;
+        EXPECT_FALSE(is_zero(b));
+    }
+}
+
+TEST(cpp, find_equal)
+{
+    std::array<evmc::address, 5> addresses{};
+    for (size_t i = 0; i < addresses.size(); ++i)
+        addresses[i].bytes[(i * 4) % sizeof(evmc::address)] = static_cast<uint8_t>(i + 1);
+    for (size_t i = 0; i < addresses.size(); ++i)
+        EXPECT_EQ(evmc::find_equal(addresses[i], addresses.data(), addresses.size()), i);
+    EXPECT_EQ(evmc::find_equal(evmc::address{}, addresses.data(), addresses.size()), 5);
+    EXPECT_EQ(evmc::find_equal(addresses[0], addresses.data(), 0), 0);
+    auto last_byte = addresses[4];
+    last_byte.bytes[19] = 1;
+    EXPECT_EQ(evmc::find_equal(last_byte, addresses.data(), addresses.size()), 5);
+
+    std::array<evmc::bytes32, 9> keys{};
+    for (size_t i = 0; i < keys.size(); ++i)
+        keys[i].bytes[(i * 4) % sizeof(evmc::bytes32)] = static_cast<uint8_t>(i + 1);
+    for (size_t i = 0; i < keys.size(); ++i)
+        EXPECT_EQ(evmc::find_equal(keys[i], keys.data(), keys.size()), i);
+    EXPECT_EQ(evmc::find_equal(0xff_bytes32, keys.data(), keys.size()), 9);
+
+    // The duplicate key: the first one is found.
+    keys[7] = keys[2];
+    EXPECT_EQ(evmc::find_equal(keys[2], keys.data(), keys.size()), 2);
+
+    static constexpr evmc::bytes32 constexpr_keys[]{0x01_bytes32, 0x02_bytes32, 0x03_bytes32};
+    static_assert(evmc::find_equal(0x03_bytes32, constexpr_keys, 3) == 2);
+    static_assert(evmc::find_equal(0x04_bytes32, constexpr_keys, 3) == 3);
+}
+
 TEST(cpp, literals)
 {
     using namespace evmc::literals;
@@ -729,6 +903,68 @@ TEST(cpp, host_call)
     EXPECT_EQ(*res.output_data, input[2]);
 }
 
+TEST(cpp, host_allocate_output)
+{
+    /// The Host providing the output memory from a fixed buffer.
+    class ArenaHost : public evmc::MockedHost
+    {
+    public:
+        uint8_t arena[64]{};
+        size_t arena_used = 0;
+
+        uint8_t* allocate_output(size_t size) noexcept override
+        {
+            if (size > sizeof(arena) - arena_used)
+                return nullptr;
+            auto* const ptr = &arena[arena_used];
+            arena_used += size;
+            return ptr;
+        }
+    };
+
+    const uint8_t output[40] = {1, 2, 3};
+
+    ArenaHost arena_host;
+    auto host = evmc::HostContext{evmc::Host::get_interface(), arena_host.to_context()};
+
+    const auto r1 = host.make_result(EVMC_SUCCESS, 1, 2, output, sizeof(output));
+    EXPECT_EQ(r1.status_code, EVMC_SUCCESS);
+    EXPECT_EQ(r1.gas_left, 1);
+    EXPECT_EQ(r1.gas_refund, 2);
+    EXPECT_EQ(r1.output_data, arena_host.arena);
+    ASSERT_EQ(r1.output_size, sizeof(output));
+    EXPECT_EQ(std::memcmp(r1.output_data, output, sizeof(output)), 0);
+    EXPECT_EQ(r1.raw().release, nullptr);
+    EXPECT_EQ(arena_host.arena_used, sizeof(output));
+
+    // No output: nothing allocated.
+    const auto r2 = host.make_result(EVMC_SUCCESS, 1, 0, nullptr, 0);
+    EXPECT_EQ(r2.output_size, 0u);
+    EXPECT_EQ(arena_host.arena_used, sizeof(output));
+
+    // The Host is out of memory: the result owns the output.
+    const auto r3 = host.make_result(EVMC_REVERT, 1, 0, output, sizeof(output));
+    EXPECT_EQ(r3.status_code, EVMC_REVERT);
+    ASSERT_EQ(r3.output_size, sizeof(output));
+    EXPECT_EQ(std::memcmp(r3.output_data, output, sizeof(output)), 0);
+    EXPECT_NE(r3.raw().release, nullptr);
+
+    // The Host without the allocator.
+    evmc::MockedHost mocked_host;
+    host = evmc::HostContext{evmc::Host::get_interface(), mocked_host.to_context()};
+    EXPECT_EQ(host.allocate_output(1), nullptr);
+    const auto r4 = host.make_result(EVMC_SUCCESS, 1, 0, output, sizeof(output));
+    ASSERT_EQ(r4.output_size, sizeof(output));
+    EXPECT_EQ(std::memcmp(r4.output_data, output, sizeof(output)), 0);
+    EXPECT_NE(r4.raw().release, nullptr);
+
+    // The C Host interface without the callback.
+    const auto raw = evmc_make_host_result(nullptr, nullptr, EVMC_SUCCESS, 1, 0, output, 1);
+    const auto r5 = evmc::Result{raw};
+    ASSERT_EQ(r5.output_size, 1u);
+    EXPECT_EQ(r5.output_data[0], 1);
+}
+
 TEST(cpp, result_raii)
 {
     static auto release_called = 0;
@@ -835,6 +1071,43 @@ TEST(cpp, result_create)
     c.release(&c);
 }
 
+TEST(cpp, result_forward)
+{
+    static int release_called = 0;
+    release_called = 0;
+    static const uint8_t output[] = {1, 2, 3};
+    {
+        auto raw = evmc_result{};
+        raw.status_code = EVMC_REVERT;
+        raw.gas_left = 10;
+        raw.output_data = output;
+        raw.output_size = sizeof(output);
+        raw.release = [](const evmc_result* r) noexcept {
+            EXPECT_EQ(r->output_data, output);
+            ++release_called;
+        };
+
+        auto child = evmc::Result{raw};
+        EXPECT_EQ(child.output(), evmc::bytes_view(output, sizeof(output)));
+
+        // The output is adopted by the parent's result with the new status and gas.
+        const auto parent = std::move(child).forward(EVMC_SUCCESS, 5, 1);
+        EXPECT_EQ(parent.status_code, EVMC_SUCCESS);
+        EXPECT_EQ(parent.gas_left, 5);
+        EXPECT_EQ(parent.gas_refund, 1);
+        EXPECT_EQ(parent.output_data, output);
+        EXPECT_EQ(parent.output_size, sizeof(output));
+        EXPECT_EQ(release_called, 0);
+    }
+    EXPECT_EQ(release_called, 1);
+
+    // The malloc'ed output.
+    auto child = evmc::Result{EVMC_SUCCESS, 1, 0, output, sizeof(output)};
+    const auto parent = std::move(child).forward(EVMC_REVERT, 0, 0);
+    EXPECT_EQ(parent.status_code, EVMC_REVERT);
+    EXPECT_EQ(parent.output(), evmc::bytes_view(output, sizeof(output)));
+}
+
 TEST(cpp, status_code_to_string)
 {
     struct TestCase
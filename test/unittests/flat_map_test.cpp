@@ -0,0 +1,199 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <evmc/evmc.hpp>
+#include <evmc/flat_map.hpp>
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <string>
+
+using evmc::flat_map;
+using namespace evmc::literals;
+
+namespace
+{
+/// The hash function mapping keys to only few values, so that the keys collide
+/// in both the group index and the control byte.
+struct colliding_hash
+{
+    size_t operator()(uint64_t x) const noexcept { return x % 3; }
+};
+}  // namespace
+
+TEST(flat_map, empty)
+{
+    const flat_map<evmc::address, int, evmc::fast_hash> m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.size(), 0u);
+    EXPECT_EQ(m.capacity(), 0u);
+    EXPECT_EQ(m.begin(), m.end());
+    EXPECT_EQ(m.find(0x01_address), m.end());
+    EXPECT_EQ(m.count(0x01_address), 0u);
+    EXPECT_THROW(m.at(0x01_address), std::out_of_range);
+}
+
+TEST(flat_map, insert_find_erase)
+{
+    flat_map<evmc::bytes32, std::string, evmc::fast_hash> m;
+    const auto [it, inserted] = m.try_emplace(0x01_bytes32, "one");
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(it->first, 0x01_bytes32);
+    EXPECT_EQ(it->second, "one");
+
+    const auto [it2, inserted2] = m.try_emplace(0x01_bytes32, "uno");
+    EXPECT_FALSE(inserted2);
+    EXPECT_EQ(it2, it);
+    EXPECT_EQ(it2->second, "one");
+
+    m[0x02_bytes32] = "two";
+    EXPECT_TRUE(m.emplace(0x03_bytes32, 3, 'x').second);
+    EXPECT_FALSE(m.insert({0x03_bytes32, "three"}).second);
+    EXPECT_EQ(m.size(), 3u);
+    EXPECT_EQ(m.at(0x02_bytes32), "two");
+    EXPECT_EQ(m.at(0x03_bytes32), "xxx");
+    EXPECT_EQ(m.count(0x03_bytes32), 1u);
+    EXPECT_EQ(m.find(0x04_bytes32), m.end());
+
+    EXPECT_EQ(m.erase(0x02_bytes32), 1u);
+    EXPECT_EQ(m.erase(0x02_bytes32), 0u);
+    EXPECT_EQ(m.size(), 2u);
+    EXPECT_EQ(m.count(0x02_bytes32), 0u);
+    EXPECT_EQ(m.at(0x01_bytes32), "one");
+
+    m.clear();
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.begin(), m.end());
+    EXPECT_EQ(m.count(0x01_bytes32), 0u);
+    EXPECT_GT(m.capacity(), 0u);
+}
+
+TEST(flat_map, iteration)
+{
+    flat_map<uint64_t, uint64_t> m;
+    for (uint64_t i = 0; i < 100; ++i)
+        m[i] = 2 * i;
+
+    uint64_t sum = 0;
+    size_t n = 0;
+    for (const auto& [key, value] : m)
+    {
+        EXPECT_EQ(value, 2 * key);
+        sum += key;
+        ++n;
+    }
+    EXPECT_EQ(n, 100u);
+    EXPECT_EQ(sum, 99u * 100 / 2);
+
+    // Erase the odd keys while iterating.
+    for (auto it = m.begin(); it != m.end();)
+    {
+        if (it->first % 2 != 0)
+            it = m.erase(it);
+        else
+            ++it;
+    }
+    EXPECT_EQ(m.size(), 50u);
+    for (auto it = m.cbegin(); it != m.cend(); ++it)
+        EXPECT_EQ(it->first % 2, 0u);
+}
+
+TEST(flat_map, reserve)
+{
+    flat_map<uint64_t, int> m;
+    m.reserve(0);
+    EXPECT_EQ(m.capacity(), 0u);
+    m.reserve(1000);
+    const auto capacity = m.capacity();
+    EXPECT_GE(capacity, 1000u);
+    for (uint64_t i = 0; i < 1000; ++i)
+        m[i] = 1;
+    EXPECT_EQ(m.capacity(), capacity);
+}
+
+TEST(flat_map, copy_and_move)
+{
+    flat_map<uint64_t, std::string> m{{1, "a"}, {2, "b"}, {3, "c"}};
+    EXPECT_EQ(m.size(), 3u);
+
+    auto copy = m;
+    copy[1] = "x";
+    EXPECT_EQ(m.at(1), "a");
+    EXPECT_EQ(copy.at(1), "x");
+    EXPECT_EQ(copy.size(), 3u);
+
+    auto moved = std::move(copy);
+    EXPECT_EQ(moved.at(1), "x");
+    EXPECT_TRUE(copy.empty());  // NOLINT(bugprone-use-after-move)
+    copy[5] = "five";           // The moved-from map is usable.
+    EXPECT_EQ(copy.size(), 1u);
+
+    m = moved;
+    EXPECT_EQ(m.at(1), "x");
+    moved = {};
+    EXPECT_TRUE(moved.empty());
+    swap(m, moved);
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(moved.size(), 3u);
+
+    const flat_map<uint64_t, std::string> from_range(moved.begin(), moved.end());
+    EXPECT_EQ(from_range.size(), 3u);
+    EXPECT_EQ(from_range.at(3), "c");
+}
+
+TEST(flat_map, colliding_keys)
+{
+    // All keys share the same 3 hash values, so they are found by probing many groups.
+    flat_map<uint64_t, uint64_t, colliding_hash> m;
+    for (uint64_t i = 0; i < 200; ++i)
+        m[i] = i;
+    EXPECT_EQ(m.size(), 200u);
+    for (uint64_t i = 0; i < 200; ++i)
+        EXPECT_EQ(m.at(i), i);
+    EXPECT_EQ(m.count(200), 0u);
+
+    for (uint64_t i = 0; i < 200; i += 2)
+        EXPECT_EQ(m.erase(i), 1u);
+    for (uint64_t i = 0; i < 200; ++i)
+        EXPECT_EQ(m.count(i), i % 2);
+}
+
+TEST(flat_map, random_operations)
+{
+    // Compare with std::map using the small key range to have many erasures and reinsertions,
+    // i.e. the deleted slots to be reused and rehashed away.
+    flat_map<uint64_t, uint64_t> m;
+    std::map<uint64_t, uint64_t> expected;
+    std::mt19937_64 rng{0};
+    for (uint64_t i = 0; i < 100000; ++i)
+    {
+        const auto key = rng() % 512;
+        switch (rng() % 4)
+        {
+        case 0:
+        case 1:
+            m[key] = i;
+            expected[key] = i;
+            break;
+        case 2:
+            ASSERT_EQ(m.erase(key), expected.erase(key));
+            break;
+        default:
+        {
+            const auto it = m.find(key);
+            const auto e = expected.find(key);
+            ASSERT_EQ(it == m.end(), e == expected.end());
+            if (e != expected.end())
+            {
+                ASSERT_EQ(it->second, e->second);
+            }
+        }
+        }
+        ASSERT_EQ(m.size(), expected.size());
+    }
+    EXPECT_LE(m.capacity(), 2048u);
+
+    std::map<uint64_t, uint64_t> elements{m.begin(), m.end()};
+    EXPECT_EQ(elements, expected);
+}
@@ -4,6 +4,7 @@
 
 #include <evmc/hex.hpp>
 #include <gtest/gtest.h>
+#include <cctype>
 
 using namespace evmc;
 
@@ -25,6 +26,77 @@ TEST(hex, hex_of_bytes)
     EXPECT_EQ(hex({nullptr, 0}), "");
 }
 
+TEST(hex, hex_to_buffer)
+{
+    const uint8_t data[] = {0x00, 0x01, 0xa0, 0xff};
+    char buffer[10] = "xxxxxxxxx";
+    const auto* const end = hex({data, sizeof(data)}, buffer);
+    EXPECT_EQ(end, &buffer[8]);
+    EXPECT_EQ(std::string_view(buffer), "0001a0ffx");
+
+    std::string str = "0x";
+    append_hex(str, {data, sizeof(data)});
+    append_hex(str, {data, 1});
+    EXPECT_EQ(str, "0x0001a0ff00");
+}
+
+TEST(hex, hex_long)
+{
+    // The lengths cover the blocks of the vectorized implementations and the remainders.
+    for (size_t size = 0; size <= 100; ++size)
+    {
+        bytes data(size, 0);
+        std::string expected;
+        for (size_t i = 0; i < size; ++i)
+        {
+            data[i] = static_cast<uint8_t>(i * 0x1d + 0x93);
+            expected += hex(data[i]);
+        }
+        EXPECT_EQ(hex(data), expected);
+        EXPECT_EQ(from_hex(expected), data);
+
+        for (auto& c : expected)
+            c = static_cast<char>(std::toupper(c));
+        EXPECT_EQ(from_hex(expected), data);
+    }
+}
+
+TEST(hex, from_hex_long_not_hex_digit)
+{
+    // The invalid characters neighbouring the hex digit ranges in every position.
+    for (const auto c : {'/', ':', '@', 'G', '`', 'g', 'x', ' ', '\0', '\xff', '\xc1'})
+    {
+        for (size_t i = 0; i < 80; ++i)
+        {
+            std::string hex(80, 'a');
+            hex[i] = c;
+            EXPECT_EQ(from_hex(hex), std::nullopt) << "position: " << i;
+            EXPECT_FALSE(validate_hex(hex));
+        }
+    }
+}
+
+TEST(hex, from_hex_to_buffer)
+{
+    uint8_t buffer[4]{};
+    EXPECT_EQ(from_hex("0x0102", buffer), 2u);
+    EXPECT_EQ(buffer[0], 0x01);
+    EXPECT_EQ(buffer[1], 0x02);
+    EXPECT_EQ(from_hex("a0ffb1c2", buffer), 4u);
+    EXPECT_EQ(hex({buffer, sizeof(buffer)}), "a0ffb1c2");
+    EXPECT_EQ(from_hex("", buffer), 0u);
+    EXPECT_EQ(from_hex("0x", buffer), 0u);
+    EXPECT_EQ(from_hex("123", buffer), std::nullopt);
+    EXPECT_EQ(from_hex("0g", buffer), std::nullopt);
+
+    bytes bs{0xaa};
+    EXPECT_TRUE(append_from_hex(bs, "0x0102"));
+    EXPECT_TRUE(append_from_hex(bs, "03"));
+    EXPECT_EQ(bs, (bytes{0xaa, 0x01, 0x02, 0x03}));
+    EXPECT_FALSE(append_from_hex(bs, "0405z6"));
+    EXPECT_EQ(bs, (bytes{0xaa, 0x01, 0x02, 0x03}));  // Unchanged.
+}
+
 TEST(hex, from_hex)
 {
     EXPECT_EQ(from_hex(""), bytes{});
@@ -0,0 +1,70 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <evmc/hex.hpp>
+#include <evmc/keccak.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+using evmc::keccak256;
+using namespace evmc::literals;
+
+namespace
+{
+/// Returns the bytes 00 01 02 ... of the given length.
+evmc::bytes sequence(size_t size)
+{
+    evmc::bytes data(size, 0);
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<uint8_t>(i);
+    return data;
+}
+}  // namespace
+
+TEST(keccak, empty)
+{
+    EXPECT_EQ(keccak256({}),
+              0xc5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470_bytes32);
+}
+
+TEST(keccak, abc)
+{
+    EXPECT_EQ(keccak256(*evmc::from_hex("616263")),
+              0x4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45_bytes32);
+}
+
+TEST(keccak, block_boundaries)
+{
+    // The rate of Keccak-256 is 136 bytes: the padding fits in the block or needs the next one.
+    EXPECT_EQ(keccak256(sequence(135)),
+              0xcbdfd9dee5faad3818d6b06f95a219fd290b0e1706f6a82e5a595b9ce9faca62_bytes32);
+    EXPECT_EQ(keccak256(sequence(136)),
+              0x7ce759f1ab7f9ce437719970c26b0a66ff11fe3e38e17df89cf5d29c7d7f807e_bytes32);
+    EXPECT_EQ(keccak256(sequence(137)),
+              0xac73d4fae68b8453f764007c1a20ce95994187861f0c3227a3a8e99a73a3b1db_bytes32);
+    EXPECT_EQ(keccak256(sequence(272)),
+              0xfdf2ec49e749960d3c8521a0219af8d03e30e2b3bf19bd16150ee0eaf133d66e_bytes32);
+    EXPECT_EQ(keccak256(sequence(300)),
+              0xa679e749a6af300c36e7ff2255d220864eab27b382f9cfdc5aa4d13563ba36ff_bytes32);
+}
+
+TEST(keccak, multi_buffer)
+{
+    // Every batch size, so all the groups of the vectorized variants and the remainders are used.
+    // The inputs of different lengths share the groups.
+    for (size_t n = 0; n <= 19; ++n)
+    {
+        std::vector<evmc::bytes> data;
+        std::vector<evmc::bytes_view> inputs;
+        for (size_t i = 0; i < n; ++i)
+            data.emplace_back(sequence((i * 67 + n) % 420));
+        for (const auto& d : data)
+            inputs.emplace_back(d);
+
+        std::vector<evmc::bytes32> outputs(n);
+        keccak256(inputs.data(), outputs.data(), n);
+        for (size_t i = 0; i < n; ++i)
+            EXPECT_EQ(outputs[i], keccak256(inputs[i])) << "n: " << n << ", i: " << i;
+    }
+}
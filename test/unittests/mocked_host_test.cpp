@@ -5,6 +5,13 @@
 #include <evmc/mocked_host.hpp>
 #include <gtest/gtest.h>
 
+// The MockedHost and MockedAccount can be forward declared.
+namespace evmc
+{
+class MockedHost;
+struct MockedAccount;
+}  // namespace evmc
+
 using namespace evmc::literals;
 
 TEST(mocked_host, mocked_account)
@@ -19,7 +26,50 @@ TEST(mocked_host, mocked_account)
     EXPECT_EQ(account.nonce, -1);
 }
 
-TEST(mocked_host, storage)
+TEST(mocked_host, mocked_account_reference)
+{
+    evmc::MockedHost host;
+    evmc::MockedAccount& account = host.accounts[0xa1_address];
+    account.nonce = 1;
+    EXPECT_EQ(host.accounts[0xa1_address].nonce, 1);
+}
+
+TEST(mocked_host, code_hash)
+{
+    const auto addr = 0x2000000000000000000000000000000000000000_address;
+    const auto code = evmc::bytes{0x60, 0x00, 0x56};
+    const auto code_keccak =
+        0x0fdb9081f94bd9b14245d0a4dbb40f171d9f0566f451abf0b2f5e8e9019642c5_bytes32;
+
+    evmc::MockedHost host;
+    EXPECT_EQ(host.get_code_hash(addr), evmc::bytes32{});
+
+    // Empty code: nothing derived.
+    auto& account = host.accounts[addr];
+    EXPECT_EQ(host.get_code_hash(addr), evmc::bytes32{});
+
+    // The hash derived from the code.
+    account.code = code;
+    EXPECT_EQ(host.get_code_hash(addr), code_keccak);
+
+    // The hash set explicitly takes precedence.
+    account.codehash = 0x01_bytes32;
+    EXPECT_EQ(host.get_code_hash(addr), 0x01_bytes32);
+
+    account.set_code(code);
+    EXPECT_EQ(account.codehash, code_keccak);
+    EXPECT_EQ(host.get_code_hash(addr), code_keccak);
+}
+
+/// The tests of the MockedHost state, instantiated for all the state containers policies.
+template <typename HostT>
+class mocked_host_state : public testing::Test
+{};
+
+using MockedHostTypes = testing::Types<evmc::MockedHost, evmc::FlatMockedHost>;
+TYPED_TEST_SUITE(mocked_host_state, MockedHostTypes);
+
+TYPED_TEST(mocked_host_state, storage)
 {
     const auto addr1 = evmc::address{};
     const auto addr2 = 0x2000000000000000000000000000000000000000_address;
@@ -27,7 +77,7 @@ TEST(mocked_host, storage)
     const auto val2 = 0x2000000000000000000000000000000000000000000000000102030405060708_bytes32;
     const auto val3 = 0x1000000000000000000000000000000000000000000000000000000000000000_bytes32;
 
-    evmc::MockedHost host;
+    TypeParam host;
     const auto& chost = host;
 
     // Null bytes returned for non-existing accounts.
@@ -72,7 +122,7 @@ TEST(mocked_host, storage)
     EXPECT_EQ(chost.get_storage(addr2, val3), val1);
 }
 
-TEST(mocked_host, storage_update_scenarios)
+TYPED_TEST(mocked_host_state, storage_update_scenarios)
 {
     static constexpr auto addr = 0xff_address;
     static constexpr auto key = 0xfe_bytes32;
@@ -80,7 +130,7 @@ TEST(mocked_host, storage_update_scenarios)
     static constexpr auto execute_scenario = [](const evmc::bytes32& original,
                                                 const evmc::bytes32& current,
                                                 const evmc::bytes32& value) {
-        evmc::MockedHost host;
+        TypeParam host;
         host.accounts[addr].storage[key] = {current, original};
         return host.set_storage(addr, key, value);
     };
@@ -132,9 +182,9 @@ TEST(mocked_host, selfdestruct)
     EXPECT_EQ(host.recorded_selfdestructs[0xdead02_address][1], 0xbece01_address);
 }
 
-TEST(mocked_host, transient_storage)
+TYPED_TEST(mocked_host_state, transient_storage)
 {
-    evmc::MockedHost host;
+    TypeParam host;
 
     // Get from non-existing account.
     EXPECT_EQ(host.get_transient_storage(0xa1_address, 0xc1_bytes32), 0x00_bytes32);
@@ -151,3 +201,132 @@ TEST(mocked_host, transient_storage)
     // Get non-existing key of existing account.
     EXPECT_EQ(host.get_transient_storage(0xa1_address, 0xc2_bytes32), 0x00_bytes32);
 }
+
+TYPED_TEST(mocked_host_state, checkpoint_revert)
+{
+    TypeParam host;
+    host.accounts[0xa1_address].storage[0x01_bytes32] = 0x11_bytes32;
+    const auto cp = host.checkpoint();
+
+    EXPECT_EQ(host.set_storage(0xa1_address, 0x01_bytes32, 0x12_bytes32), EVMC_STORAGE_MODIFIED);
+    EXPECT_EQ(host.set_storage(0xa1_address, 0x02_bytes32, 0x22_bytes32), EVMC_STORAGE_ADDED);
+    EXPECT_EQ(host.set_storage(0xa2_address, 0x01_bytes32, 0x33_bytes32), EVMC_STORAGE_ADDED);
+    EXPECT_EQ(host.access_storage(0xa1_address, 0x01_bytes32), EVMC_ACCESS_COLD);
+    host.set_transient_storage(0xa1_address, 0x01_bytes32, 0x44_bytes32);
+    host.set_transient_storage(0xa3_address, 0x01_bytes32, 0x55_bytes32);
+    host.selfdestruct(0xa1_address, 0xbe_address);
+    host.emit_log(0xa1_address, nullptr, 0, nullptr, 0);
+    EXPECT_EQ(host.accounts.size(), 3u);
+    EXPECT_EQ(host.recorded_logs.size(), 1u);
+
+    host.revert(cp);
+    ASSERT_EQ(host.accounts.size(), 1u);
+    const auto& acc = host.accounts[0xa1_address];
+    ASSERT_EQ(acc.storage.size(), 1u);
+    EXPECT_EQ(acc.storage.at(0x01_bytes32).current, 0x11_bytes32);
+    EXPECT_EQ(acc.storage.at(0x01_bytes32).original, 0x11_bytes32);
+    EXPECT_EQ(acc.storage.at(0x01_bytes32).access_status, EVMC_ACCESS_COLD);
+    EXPECT_TRUE(acc.transient_storage.empty());
+    EXPECT_TRUE(host.recorded_selfdestructs.empty());
+    EXPECT_TRUE(host.recorded_logs.empty());
+    EXPECT_TRUE(host.recorded_account_accesses.empty());
+
+    // The same checkpoint can be reverted to multiple times.
+    EXPECT_EQ(host.set_storage(0xa1_address, 0x01_bytes32, 0x12_bytes32), EVMC_STORAGE_MODIFIED);
+    host.revert(cp);
+    EXPECT_EQ(host.get_storage(0xa1_address, 0x01_bytes32), 0x11_bytes32);
+}
+
+TYPED_TEST(mocked_host_state, checkpoint_nested)
+{
+    TypeParam host;
+    const auto cp1 = host.checkpoint();
+    host.set_transient_storage(0xa1_address, 0x01_bytes32, 0x01_bytes32);
+    const auto cp2 = host.checkpoint();
+    host.set_transient_storage(0xa1_address, 0x01_bytes32, 0x02_bytes32);
+    host.set_transient_storage(0xa1_address, 0x02_bytes32, 0x02_bytes32);
+    EXPECT_EQ(host.get_transient_storage(0xa1_address, 0x01_bytes32), 0x02_bytes32);
+
+    host.revert(cp2);
+    EXPECT_EQ(host.get_transient_storage(0xa1_address, 0x01_bytes32), 0x01_bytes32);
+    EXPECT_EQ(host.accounts[0xa1_address].transient_storage.count(0x02_bytes32), 0u);
+
+    host.revert(cp1);
+    EXPECT_EQ(host.accounts.count(0xa1_address), 0u);
+}
+
+TYPED_TEST(mocked_host_state, commit_transaction)
+{
+    TypeParam host;
+    host.accounts[0xa1_address].storage[0x01_bytes32] = 0x11_bytes32;
+    host.accounts[0xa1_address].storage[0x02_bytes32] = 0x22_bytes32;
+
+    EXPECT_EQ(host.access_account(0xa1_address), EVMC_ACCESS_COLD);
+    EXPECT_EQ(host.access_storage(0xa1_address, 0x01_bytes32), EVMC_ACCESS_COLD);
+    EXPECT_EQ(host.set_storage(0xa1_address, 0x01_bytes32, 0x12_bytes32), EVMC_STORAGE_MODIFIED);
+    EXPECT_EQ(host.set_storage(0xa2_address, 0x01_bytes32, 0x33_bytes32), EVMC_STORAGE_ADDED);
+    host.set_transient_storage(0xa1_address, 0x01_bytes32, 0x44_bytes32);
+    host.set_transient_storage(0xa1_address, 0x02_bytes32, 0x45_bytes32);
+
+    host.commit_transaction();
+    const auto& s1 = host.accounts[0xa1_address].storage.at(0x01_bytes32);
+    EXPECT_EQ(s1.current, 0x12_bytes32);
+    EXPECT_EQ(s1.original, 0x12_bytes32);
+    EXPECT_EQ(s1.access_status, EVMC_ACCESS_COLD);
+    const auto& s2 = host.accounts[0xa2_address].storage.at(0x01_bytes32);
+    EXPECT_EQ(s2.current, 0x33_bytes32);
+    EXPECT_EQ(s2.original, 0x33_bytes32);
+    EXPECT_EQ(host.accounts[0xa1_address].storage.at(0x02_bytes32).current, 0x22_bytes32);
+    EXPECT_TRUE(host.accounts[0xa1_address].transient_storage.empty());
+    EXPECT_TRUE(host.recorded_account_accesses.empty());
+
+    // The next transaction starts with the committed state.
+    EXPECT_EQ(host.access_account(0xa1_address), EVMC_ACCESS_COLD);
+    EXPECT_EQ(host.access_storage(0xa1_address, 0x01_bytes32), EVMC_ACCESS_COLD);
+    EXPECT_EQ(host.set_storage(0xa1_address, 0x01_bytes32, 0x00_bytes32), EVMC_STORAGE_DELETED);
+    EXPECT_EQ(host.get_transient_storage(0xa1_address, 0x01_bytes32), 0x00_bytes32);
+}
+
+TYPED_TEST(mocked_host_state, commit_transaction_after_revert)
+{
+    TypeParam host;
+    host.accounts[0xa1_address].storage[0x01_bytes32] = 0x11_bytes32;
+
+    EXPECT_EQ(host.set_storage(0xa1_address, 0x01_bytes32, 0x12_bytes32), EVMC_STORAGE_MODIFIED);
+    const auto cp = host.checkpoint();
+    EXPECT_EQ(host.set_storage(0xa1_address, 0x02_bytes32, 0x22_bytes32), EVMC_STORAGE_ADDED);
+    EXPECT_EQ(host.set_storage(0xa1_address, 0x01_bytes32, 0x13_bytes32), EVMC_STORAGE_ASSIGNED);
+    host.set_transient_storage(0xa1_address, 0x01_bytes32, 0x44_bytes32);
+    host.revert(cp);
+
+    // Only the changes done before the checkpoint are committed.
+    host.commit_transaction();
+    const auto& storage = host.accounts[0xa1_address].storage;
+    ASSERT_EQ(storage.size(), 1u);
+    EXPECT_EQ(storage.at(0x01_bytes32).current, 0x12_bytes32);
+    EXPECT_EQ(storage.at(0x01_bytes32).original, 0x12_bytes32);
+    EXPECT_TRUE(host.accounts[0xa1_address].transient_storage.empty());
+
+    // The checkpoints are discarded so the state changes are not journaled anymore.
+    EXPECT_EQ(host.set_storage(0xa1_address, 0x01_bytes32, 0x14_bytes32), EVMC_STORAGE_MODIFIED);
+    const auto cp2 = host.checkpoint();
+    EXPECT_EQ(cp2, 0u);
+    EXPECT_EQ(host.set_storage(0xa1_address, 0x01_bytes32, 0x15_bytes32), EVMC_STORAGE_ASSIGNED);
+    host.revert(cp2);
+    EXPECT_EQ(host.get_storage(0xa1_address, 0x01_bytes32), 0x14_bytes32);
+}
+
+TEST(mocked_host, std_map_policy)
+{
+    // The state in the node-based maps: the references remain valid after insertions.
+    evmc::BasicMockedHost<evmc::StdMapPolicy> host;
+    const auto& value = host.accounts[0xa1_address].storage[0x01_bytes32];
+    const auto cp = host.checkpoint();
+    EXPECT_EQ(host.set_storage(0xa1_address, 0x01_bytes32, 0x11_bytes32), EVMC_STORAGE_ADDED);
+    for (uint8_t i = 2; i < 100; ++i)
+        host.set_storage(evmc::address{i}, evmc::bytes32{i}, 0x01_bytes32);
+    EXPECT_EQ(value.current, 0x11_bytes32);
+    host.revert(cp);
+    EXPECT_EQ(host.accounts.size(), 1u);
+    EXPECT_EQ(value.current, 0x00_bytes32);
+}
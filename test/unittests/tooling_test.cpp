@@ -2,17 +2,39 @@
 // Copyright 2020 The EVMC Authors.
 // Licensed under the Apache License, Version 2.0.
 
+#include "examples/example_precompiles_vm/example_precompiles_vm.h"
 #include "examples/example_vm/example_vm.h"
 #include <evmc/hex.hpp>
 #include <evmc/tooling.hpp>
 #include <gtest/gtest.h>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
 #include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cstring>
+#endif
 
 using namespace evmc::tooling;
 using evmc::from_hex;
 
 namespace
 {
+/// Writes the contents to the temporary file and returns its path.
+std::string write_temp_file(const std::string& name, std::string_view contents)
+{
+    const auto path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream{path, std::ios::binary}.write(contents.data(),
+                                                static_cast<std::streamsize>(contents.size()));
+    return path;
+}
+
 std::string out_pattern(const char* rev,
                         int gas_limit,
                         const char* status,
@@ -173,3 +195,1197 @@ TEST(tool_commands, bench_inconsistent_output)
     EXPECT_NE(o.find("Result:   success"), std::string::npos);
     EXPECT_NE(o.find("Gas used: 10"), std::string::npos);
 }
+
+TEST(tool_commands, bench_options)
+{
+    auto vm = evmc::VM{evmc_create_example_vm()};
+    std::ostringstream out;
+    std::ostringstream report;
+
+    RunOptions options;
+    options.bench.emplace();
+    options.bench->warmup_iterations = 1;
+    options.bench->num_samples = 5;
+    options.bench->sample_time = std::chrono::microseconds{100};
+    options.bench->report = &report;
+
+    const auto exit_code = run(vm, EVMC_LONDON, 200, *from_hex("60028001"), {}, options, out);
+    EXPECT_EQ(exit_code, 0);
+
+    const auto o = out.str();
+    EXPECT_NE(o.find("Time:     "), std::string::npos);
+    EXPECT_NE(o.find(" ns (median of 5 samples, "), std::string::npos);
+    EXPECT_NE(o.find("          min: "), std::string::npos);
+    EXPECT_NE(o.find("95% CI: ["), std::string::npos);
+    EXPECT_NE(o.find("Gas rate: "), std::string::npos);
+    EXPECT_NE(o.find("Gas used: 3"), std::string::npos);
+
+    const auto r = report.str();
+    EXPECT_EQ(r.front(), '{');
+    EXPECT_NE(r.find("\"vm\": \"example_vm\""), std::string::npos);
+    EXPECT_NE(r.find("\"revision\": \"London\""), std::string::npos);
+    EXPECT_NE(r.find("\"gas_used\": 3,"), std::string::npos);
+    EXPECT_NE(r.find("\"num_samples\": 5,"), std::string::npos);
+    EXPECT_NE(r.find("\"median\": "), std::string::npos);
+}
+
+TEST(tool_commands, bench_stats)
+{
+    const auto s = compute_stats({5, 1, 4, 2, 3});
+    EXPECT_EQ(s.num_samples, 5u);
+    EXPECT_EQ(s.min, 1);
+    EXPECT_EQ(s.max, 5);
+    EXPECT_EQ(s.mean, 3);
+    EXPECT_EQ(s.median, 3);
+    EXPECT_DOUBLE_EQ(s.p90, 4.6);
+    EXPECT_DOUBLE_EQ(s.p99, 4.96);
+    EXPECT_DOUBLE_EQ(s.stddev, std::sqrt(2.5));
+    EXPECT_NEAR(s.ci95_low, 3 - 2.776 * std::sqrt(2.5 / 5), 1e-9);
+    EXPECT_NEAR(s.ci95_high, 3 + 2.776 * std::sqrt(2.5 / 5), 1e-9);
+    EXPECT_EQ(s.num_outliers, 0u);
+
+    const auto single = compute_stats({7});
+    EXPECT_EQ(single.median, 7);
+    EXPECT_EQ(single.stddev, 0);
+    EXPECT_EQ(single.ci95_low, 7);
+    EXPECT_EQ(single.ci95_high, 7);
+}
+
+TEST(tool_commands, bench_stats_outliers)
+{
+    const auto s = compute_stats({10, 10, 11, 10, 12, 11, 10, 11, 100, 1});
+    EXPECT_EQ(s.min, 1);
+    EXPECT_EQ(s.max, 100);
+    EXPECT_EQ(s.median, 10.5);
+    EXPECT_EQ(s.num_outliers, 2u);
+}
+
+TEST(tool_commands, bench_report_csv)
+{
+    BenchResult result;
+    result.vm_name = "vm";
+    result.vm_version = "1.0";
+    result.rev = EVMC_CANCUN;
+    result.gas_used = 2000;
+    result.batch_size = 10;
+    result.samples = {1000, 2000, 3000};
+    result.stats = compute_stats(result.samples);
+    EXPECT_EQ(result.gas_rate(), 1000);
+
+    std::ostringstream out;
+    write_report(out, ReportFormat::csv, result);
+    EXPECT_EQ(out.str(),
+              "vm,vm_version,revision,gas_used,batch_size,num_samples,min_ns,max_ns,mean_ns,"
+              "median_ns,p90_ns,p99_ns,stddev_ns,ci95_low_ns,ci95_high_ns,num_outliers,"
+              "mgas_per_s\n"
+              "vm,1.0,Cancun,2000,10,3,1000,3000,2000,2000,2800,2980,1000,-484.3382083,"
+              "4484.338208,0,1000\n");
+}
+
+TEST(tool_commands, bench_report_escaping)
+{
+    BenchResult result;
+    result.vm_name = "my \"vm\", x";
+    result.vm_version = "1.0\\\n\x01";
+    result.samples = {1000};
+    result.stats = compute_stats(result.samples);
+
+    std::ostringstream json;
+    write_report(json, ReportFormat::json, result);
+    EXPECT_NE(json.str().find("\"vm\": \"my \\\"vm\\\", x\",\n"), std::string::npos);
+    EXPECT_NE(json.str().find("\"vm_version\": \"1.0\\\\\\n\\u0001\",\n"), std::string::npos);
+
+    std::ostringstream csv;
+    write_report(csv, ReportFormat::csv, result);
+    EXPECT_NE(csv.str().find("\n\"my \"\"vm\"\", x\",\"1.0\\\n\x01\","), std::string::npos);
+}
+
+TEST(tool_commands, bench_isolate_state)
+{
+    // Yul: x := sload(0) sstore(0, 1) mstore(0, x) return(31, 1)
+    auto vm = evmc::VM{evmc_create_example_vm()};
+    std::ostringstream out;
+
+    RunOptions options;
+    options.bench.emplace();
+    options.bench->num_samples = 3;
+    options.bench->sample_time = std::chrono::microseconds{100};
+    options.bench->isolate_state = true;
+
+    const auto code = *from_hex("60005460016000556000526001601ff3");
+    const auto exit_code = run(vm, EVMC_BYZANTIUM, 200, code, {}, options, out);
+    EXPECT_EQ(exit_code, 0);
+
+    const auto o = out.str();
+    EXPECT_EQ(o.find("WARNING!"), std::string::npos);
+    EXPECT_NE(o.find("Time:     "), std::string::npos);
+    EXPECT_NE(o.find("Result:   success"), std::string::npos);
+    EXPECT_NE(o.find("Output:   00\n"), std::string::npos);
+}
+
+TEST(tool_commands, bench_corpus)
+{
+    std::vector<std::pair<std::string, evmc::VM>> vms;
+    vms.emplace_back("vm1", evmc::VM{evmc_create_example_vm()});
+    vms.emplace_back("vm2", evmc::VM{evmc_create_example_vm()});
+    const std::vector<BenchCase> cases{
+        {"add", *from_hex("6002800160005260206000f3"), {}, std::nullopt},
+        {"copy_input", *from_hex("600035600052596000f3"), *from_hex("aabbccdd"), std::nullopt},
+    };
+
+    CorpusBenchOptions options;
+    options.bench.warmup_iterations = 0;
+    options.bench.num_samples = 2;
+    options.bench.sample_time = std::chrono::microseconds{100};
+    std::ostringstream results;
+    options.results = &results;
+
+    std::ostringstream out;
+    const auto exit_code = bench_corpus(vms, cases, EVMC_CANCUN, 1000, options, out);
+    EXPECT_EQ(exit_code, 0);
+
+    const auto o = out.str();
+    EXPECT_NE(o.find("Benchmarking 2 cases on 2 VMs (Cancun, 1000 gas limit)\n"
+                     "  [1] vm1\n  [2] vm2\n"),
+              std::string::npos);
+    EXPECT_NE(o.find("[1] ns/exec"), std::string::npos);
+    EXPECT_NE(o.find("[2] Mgas/s"), std::string::npos);
+    EXPECT_NE(o.find("\nadd "), std::string::npos);
+    EXPECT_NE(o.find("\ncopy_input "), std::string::npos);
+    EXPECT_EQ(o.find("WARNING!"), std::string::npos);
+    EXPECT_EQ(o.find("Baseline"), std::string::npos);
+
+    const auto r = results.str();
+    EXPECT_NE(r.find("\"revision\": \"Cancun\""), std::string::npos);
+    EXPECT_NE(r.find("{\"vm\": \"vm2\", \"case\": \"copy_input\", \"status\": \"success\", "
+                     "\"gas_used\": 7, "),
+              std::string::npos);
+}
+
+TEST(tool_commands, bench_corpus_baseline)
+{
+    std::vector<std::pair<std::string, evmc::VM>> vms;
+    vms.emplace_back("vm", evmc::VM{evmc_create_example_vm()});
+    const std::vector<BenchCase> cases{
+        {"fast", *from_hex("00"), {}, std::nullopt},
+        {"slow", *from_hex("6002800100"), {}, std::nullopt},
+        {"new", *from_hex("6000"), {}, std::nullopt},
+    };
+
+    // The baseline has impossibly low time for "slow" and impossibly high time for "fast".
+    std::istringstream baseline{
+        R"({"revision": "Cancun", "results": [
+            {"vm": "vm", "case": "fast", "median_ns": 1e12},
+            {"vm": "vm", "case": "slow", "median_ns": 1e-6},
+            {"vm": "other", "case": "new", "median_ns": 1e-6}
+        ]})"};
+
+    CorpusBenchOptions options;
+    options.bench.warmup_iterations = 0;
+    options.bench.num_samples = 2;
+    options.bench.sample_time = std::chrono::microseconds{100};
+    options.baseline = &baseline;
+    options.threshold = 0.1;
+
+    std::ostringstream out;
+    const auto exit_code = bench_corpus(vms, cases, EVMC_CANCUN, 1000, options, out);
+    EXPECT_EQ(exit_code, 1);
+
+    const auto o = out.str();
+    EXPECT_NE(o.find("Baseline comparison (threshold 10.0%):\n"), std::string::npos);
+    const auto fast_pos = o.find("  fast [1]: ");
+    const auto slow_pos = o.find("  slow [1]: ");
+    ASSERT_NE(fast_pos, std::string::npos);
+    ASSERT_NE(slow_pos, std::string::npos);
+    const auto fast_line = o.substr(fast_pos, o.find('\n', fast_pos) - fast_pos);
+    const auto slow_line = o.substr(slow_pos, o.find('\n', slow_pos) - slow_pos);
+    EXPECT_EQ(fast_line.find("REGRESSION"), std::string::npos);
+    EXPECT_NE(slow_line.find(" REGRESSION"), std::string::npos);
+    EXPECT_EQ(o.find("  new [1]: "), std::string::npos);
+    EXPECT_NE(o.find("1 regressions\n"), std::string::npos);
+
+    std::istringstream invalid_baseline{R"({"results": [{"vm": "vm"}]})"};
+    options.baseline = &invalid_baseline;
+    EXPECT_THROW(bench_corpus(vms, cases, EVMC_CANCUN, 1000, options, out), std::invalid_argument);
+}
+
+TEST(host_recording, record_replay)
+{
+    using namespace evmc::literals;
+    constexpr auto addr = 0x000000000000000000000000000000000000aaaa_address;
+    constexpr auto key = 0x01_bytes32;
+
+    evmc::MockedHost mocked_host;
+    mocked_host.accounts[addr].code = *from_hex("6001600055");
+    mocked_host.accounts[addr].balance = 0x0100_bytes32;
+    mocked_host.tx_context.block_number = 42;
+    const evmc::bytes32 blob_hashes[] = {0x0a_bytes32, 0x0b_bytes32};
+    mocked_host.tx_context.blob_hashes = blob_hashes;
+    mocked_host.tx_context.blob_hashes_count = std::size(blob_hashes);
+    mocked_host.block_hash = 0xbb_bytes32;
+    mocked_host.call_result.output_data = blob_hashes[0].bytes;
+    mocked_host.call_result.output_size = 3;
+    mocked_host.call_result.gas_left = 7;
+
+    evmc_message msg{};
+    msg.recipient = addr;
+    msg.gas = 100;
+
+    RecordingHost recorder{mocked_host};
+    uint8_t code_buffer[3]{};
+    EXPECT_TRUE(recorder.account_exists(addr));
+    EXPECT_EQ(recorder.set_storage(addr, key, 0x02_bytes32), EVMC_STORAGE_ADDED);
+    EXPECT_EQ(recorder.get_storage(addr, key), 0x02_bytes32);
+    EXPECT_EQ(recorder.get_balance(addr), 0x0100_bytes32);
+    EXPECT_EQ(recorder.get_code_size(addr), 5);
+    EXPECT_EQ(recorder.copy_code(addr, 1, code_buffer, std::size(code_buffer)), 3);
+    EXPECT_EQ(recorder.get_tx_context().block_number, 42);
+    EXPECT_EQ(recorder.get_block_hash(1), 0xbb_bytes32);
+    EXPECT_EQ(recorder.call(msg).gas_left, 7);
+    recorder.emit_log(addr, code_buffer, std::size(code_buffer), &key, 1);
+    EXPECT_EQ(recorder.access_storage(addr, key), EVMC_ACCESS_COLD);
+    EXPECT_EQ(mocked_host.recorded_calls.size(), 1);
+    EXPECT_EQ(mocked_host.recorded_logs.size(), 1);
+
+    ReplayHost replay{recorder.recording()};
+    for (int i = 0; i < 2; ++i)
+    {
+        replay.rewind();
+        std::fill(std::begin(code_buffer), std::end(code_buffer), uint8_t{0});
+        EXPECT_TRUE(replay.account_exists(addr));
+        EXPECT_EQ(replay.set_storage(addr, key, 0x02_bytes32), EVMC_STORAGE_ADDED);
+        EXPECT_EQ(replay.get_storage(addr, key), 0x02_bytes32);
+        EXPECT_EQ(replay.get_balance(addr), 0x0100_bytes32);
+        EXPECT_EQ(replay.get_code_size(addr), 5);
+        EXPECT_EQ(replay.copy_code(addr, 1, code_buffer, std::size(code_buffer)), 3);
+        EXPECT_EQ(evmc::hex({code_buffer, std::size(code_buffer)}), "016000");
+
+        const auto tx = replay.get_tx_context();
+        EXPECT_EQ(tx.block_number, 42);
+        ASSERT_EQ(tx.blob_hashes_count, 2);
+        EXPECT_EQ(tx.blob_hashes[1], 0x0b_bytes32);
+        EXPECT_EQ(tx.initcodes_count, 0);
+
+        EXPECT_EQ(replay.get_block_hash(1), 0xbb_bytes32);
+        const auto call_result = replay.call(msg);
+        EXPECT_EQ(call_result.status_code, EVMC_SUCCESS);
+        EXPECT_EQ(call_result.gas_left, 7);
+        EXPECT_EQ(evmc::hex({call_result.output_data, call_result.output_size}), "000000");
+        replay.emit_log(addr, code_buffer, std::size(code_buffer), &key, 1);
+        EXPECT_EQ(replay.access_storage(addr, key), EVMC_ACCESS_COLD);
+        EXPECT_FALSE(replay.diverged());
+        EXPECT_TRUE(replay.finished());
+    }
+
+    // The host state is not touched by the replay.
+    EXPECT_EQ(mocked_host.recorded_calls.size(), 1);
+    EXPECT_EQ(mocked_host.recorded_logs.size(), 1);
+}
+
+TEST(host_recording, replay_diverged)
+{
+    using namespace evmc::literals;
+    evmc::MockedHost mocked_host;
+    mocked_host.accounts[0x01_address].storage[0x01_bytes32].current = 0x11_bytes32;
+
+    RecordingHost recorder{mocked_host};
+    EXPECT_EQ(recorder.get_storage(0x01_address, 0x01_bytes32), 0x11_bytes32);
+    EXPECT_EQ(recorder.get_storage(0x01_address, 0x02_bytes32), evmc::bytes32{});
+
+    ReplayHost replay{recorder.recording()};
+    EXPECT_EQ(replay.get_storage(0x01_address, 0x01_bytes32), 0x11_bytes32);
+    const auto position = replay.position();
+    EXPECT_FALSE(replay.account_exists(0x01_address));
+    EXPECT_TRUE(replay.diverged());
+    EXPECT_EQ(replay.get_storage(0x01_address, 0x02_bytes32), evmc::bytes32{});
+    EXPECT_TRUE(replay.diverged());
+
+    replay.rewind(position);
+    EXPECT_FALSE(replay.diverged());
+    EXPECT_EQ(replay.get_storage(0x01_address, 0x03_bytes32), evmc::bytes32{});
+    EXPECT_TRUE(replay.diverged());
+
+    // Replaying past the end of the recording.
+    replay.rewind(position);
+    EXPECT_EQ(replay.get_storage(0x01_address, 0x02_bytes32), evmc::bytes32{});
+    EXPECT_TRUE(replay.finished());
+    EXPECT_FALSE(replay.diverged());
+    EXPECT_EQ(replay.get_storage(0x01_address, 0x02_bytes32), evmc::bytes32{});
+    EXPECT_TRUE(replay.diverged());
+}
+
+TEST(host_recording, replay_invalid)
+{
+    EXPECT_THROW(ReplayHost{{}}, std::invalid_argument);
+    EXPECT_THROW(ReplayHost{*from_hex("45564d4352454302")}, std::invalid_argument);
+
+    // The valid header and the valid empty get_tx_context record.
+    EXPECT_NO_THROW(ReplayHost{*from_hex("45564d4352454301")});
+    EXPECT_NO_THROW(ReplayHost{*from_hex("45564d4352454301090000000000000000")});
+    EXPECT_THROW(ReplayHost{*from_hex("45564d43524543010900000000000000")}, std::invalid_argument);
+    EXPECT_THROW(
+        ReplayHost{*from_hex("45564d4352454301100000000000000000")}, std::invalid_argument);
+}
+
+TEST(host_recording, allocate_output)
+{
+    /// The Host providing the output memory from a fixed buffer.
+    class ArenaHost : public evmc::MockedHost
+    {
+    public:
+        uint8_t arena[16]{};
+
+        uint8_t* allocate_output(size_t size) noexcept override
+        {
+            return size <= sizeof(arena) ? arena : nullptr;
+        }
+    };
+
+    ArenaHost arena_host;
+    RecordingHost recorder{arena_host};
+    EXPECT_EQ(recorder.allocate_output(1), arena_host.arena);
+    EXPECT_EQ(recorder.allocate_output(17), nullptr);
+    EXPECT_EQ(recorder.recording().size(), 8u);  // Only the header.
+
+    ReplayHost replay{recorder.recording(), &arena_host};
+    EXPECT_EQ(replay.allocate_output(1), arena_host.arena);
+    EXPECT_FALSE(replay.diverged());
+    EXPECT_EQ(ReplayHost{recorder.recording()}.allocate_output(1), nullptr);
+
+    HostProfiler profiler{1};
+    InstrumentedHost host{arena_host, profiler};
+    EXPECT_EQ(host.allocate_output(1), arena_host.arena);
+    EXPECT_EQ(profiler.stats()[static_cast<size_t>(HostMethod::allocate_output)].num_calls, 1);
+    EXPECT_STREQ(to_string(HostMethod::allocate_output), "allocate_output");
+}
+
+TEST(tool_commands, run_record_replay)
+{
+    // Yul: sstore(0, number()) mstore(0, sload(0)) return(0, 32)
+    const auto code = *from_hex("4360005560005460005260206000f3");
+    auto vm = evmc::VM{evmc_create_example_vm()};
+
+    std::ostringstream recording;
+    RunOptions options;
+    options.record = &recording;
+    std::ostringstream out;
+    EXPECT_EQ(run(vm, EVMC_CANCUN, 100000, code, {}, options, out), 0);
+    const auto expected_out = out.str();
+
+    const auto r = recording.str();
+    ReplayHost replay{{r.begin(), r.end()}};
+    RunOptions replay_options;
+    replay_options.replay = &replay;
+    replay_options.bench.emplace();
+    replay_options.bench->num_samples = 2;
+    replay_options.bench->sample_time = std::chrono::microseconds{100};
+    out.str({});
+    EXPECT_EQ(run(vm, EVMC_CANCUN, 100000, code, {}, replay_options, out), 0);
+    const auto o = out.str();
+    EXPECT_EQ(o.find("WARNING!"), std::string::npos);
+    EXPECT_NE(o.find("Time:     "), std::string::npos);
+    EXPECT_NE(o.find(expected_out.substr(expected_out.find("Result:"))), std::string::npos);
+    EXPECT_FALSE(replay.diverged());
+
+    // Replaying different code diverges.
+    replay.rewind();
+    replay_options.bench.reset();
+    out.str({});
+    run(vm, EVMC_CANCUN, 100000, *from_hex("60005460005260206000f3"), {}, replay_options, out);
+    EXPECT_NE(out.str().find("WARNING! Execution diverged from the host recording\n"),
+              std::string::npos);
+}
+
+TEST(tool_commands, bench_scaling)
+{
+    // Yul: x := sload(0) sstore(0, 1) mstore(0, x) return(31, 1)
+    const auto code = *from_hex("60005460016000556000526001601ff3");
+    auto vm = evmc::VM{evmc_create_example_vm()};
+
+    evmc::FlatMockedHost state;
+    evmc_message msg{};
+    msg.gas = 100000;
+
+    BenchOptions options;
+    options.warmup_iterations = 1;
+    options.num_samples = 1;
+    options.sample_time = std::chrono::milliseconds{5};
+    options.isolate_state = true;
+    options.num_threads = 3;
+    options.cpus = {0};
+
+    const auto r = measure_scaling(vm, EVMC_CANCUN, msg, code, state, options);
+    EXPECT_EQ(r.gas_used, 10);
+    EXPECT_GT(r.single_thread_throughput, 0);
+    ASSERT_EQ(r.threads.size(), 3);
+    for (const auto& t : r.threads)
+    {
+        EXPECT_GT(t.num_executions, 0);
+        EXPECT_GT(t.throughput, 0);
+#ifdef __linux__
+        EXPECT_EQ(t.cpu, 0);
+#endif
+    }
+    EXPECT_GT(r.throughput(), r.threads[0].throughput);
+    EXPECT_GT(r.efficiency(), 0);
+
+    // The state of the prototype host is not modified.
+    EXPECT_TRUE(state.accounts.empty());
+}
+
+TEST(tool_commands, bench_scaling_run)
+{
+    auto vm = evmc::VM{evmc_create_example_vm()};
+    std::ostringstream out;
+
+    RunOptions options;
+    options.bench.emplace();
+    options.bench->num_samples = 2;
+    options.bench->sample_time = std::chrono::microseconds{500};
+    options.bench->num_threads = 2;
+
+    const auto code = *from_hex("60028001");
+    EXPECT_EQ(run(vm, EVMC_CANCUN, 100, code, {}, options, out), 0);
+    const auto o = out.str();
+    EXPECT_NE(o.find("Scaling:  1 thread: "), std::string::npos);
+    EXPECT_NE(o.find("\n          2 threads: "), std::string::npos);
+    EXPECT_NE(o.find("\n          thread 0: "), std::string::npos);
+    EXPECT_NE(o.find("\n          thread 1: "), std::string::npos);
+
+    ReplayHost replay{*from_hex("45564d4352454301")};
+    options.replay = &replay;
+    EXPECT_THROW(run(vm, EVMC_CANCUN, 100, code, {}, options, out), std::invalid_argument);
+}
+
+TEST(tool_commands, bench_perf_counters)
+{
+    auto vm = evmc::VM{evmc_create_example_vm()};
+    std::ostringstream out;
+    std::ostringstream report;
+
+    RunOptions options;
+    options.bench.emplace();
+    options.bench->num_samples = 2;
+    options.bench->sample_time = std::chrono::microseconds{100};
+    options.bench->perf_counters = true;
+    options.bench->report = &report;
+
+    EXPECT_EQ(run(vm, EVMC_CANCUN, 100, *from_hex("60028001"), {}, options, out), 0);
+
+    // The counters may be not available (e.g. in containers), but the line is always present.
+    const auto o = out.str();
+    const auto counters_pos = o.find("\nCounters: ");
+    ASSERT_NE(counters_pos, std::string::npos);
+    EXPECT_LT(o.find("\nTime:     "), counters_pos);
+    EXPECT_GT(o.find("\nGas rate: "), counters_pos);
+
+    const auto r = report.str();
+    EXPECT_NE(r.find("\"perf\": {\"cycles\": "), std::string::npos);
+    EXPECT_NE(r.find(", \"dtlb_misses\": "), std::string::npos);
+    EXPECT_NE(r.find(", \"ipc\": "), std::string::npos);
+}
+
+TEST(tool_commands, bench_report_perf_counters)
+{
+    BenchResult result;
+    result.vm_name = "vm";
+    result.vm_version = "1.0";
+    result.rev = EVMC_CANCUN;
+    result.gas_used = 2000;
+    result.batch_size = 10;
+    result.samples = {1000};
+    result.stats = compute_stats(result.samples);
+    result.perf.emplace();
+    result.perf->values[static_cast<size_t>(PerfEvent::cycles)] = 4000;
+    result.perf->values[static_cast<size_t>(PerfEvent::instructions)] = 10000;
+    result.perf->values[static_cast<size_t>(PerfEvent::llc_misses)] = 0.5;
+    EXPECT_EQ(result.perf->ipc(), 2.5);
+    EXPECT_EQ((*result.perf)[PerfEvent::branch_misses], std::nullopt);
+
+    std::ostringstream csv;
+    write_report(csv, ReportFormat::csv, result);
+    const auto c = csv.str();
+    EXPECT_NE(c.find(",mgas_per_s,cycles,instructions,branch_misses,l1d_misses,llc_misses,"
+                     "dtlb_misses,ipc\n"),
+              std::string::npos);
+    EXPECT_NE(c.find(",2000,4000,10000,,,0.5,,2.5\n"), std::string::npos);
+
+    std::ostringstream json;
+    write_report(json, ReportFormat::json, result);
+    EXPECT_NE(json.str().find("  \"perf\": {\"cycles\": 4000, \"instructions\": 10000, "
+                              "\"branch_misses\": null, \"l1d_misses\": null, "
+                              "\"llc_misses\": 0.5, \"dtlb_misses\": null, \"ipc\": 2.5},\n"),
+              std::string::npos);
+}
+
+TEST(tool_commands, bench_allocations)
+{
+    // Yul: sstore(0, 1) return(0, 32)
+    const auto code = *from_hex("600160005560206000f3");
+    auto vm = evmc::VM{evmc_create_example_vm()};
+    std::ostringstream out;
+    std::ostringstream report;
+
+    RunOptions options;
+    options.bench.emplace();
+    options.bench->num_samples = 2;
+    options.bench->sample_time = std::chrono::microseconds{100};
+    options.bench->isolate_state = true;
+    options.bench->track_allocations = true;
+    options.bench->report = &report;
+
+    EXPECT_EQ(run(vm, EVMC_CANCUN, 100000, code, {}, options, out), 0);
+    const auto o = out.str();
+    if (!alloc_tracking_available())
+    {
+        EXPECT_NE(o.find("\nAllocs:   not available (requires glibc"), std::string::npos);
+        return;
+    }
+
+    EXPECT_NE(o.find("\nAllocs:   VM: "), std::string::npos);
+    EXPECT_NE(report.str().find("\"allocs\": {\"vm\": {\"num_allocations\": "), std::string::npos);
+
+    evmc::MockedHost host;
+    evmc_message msg{};
+    msg.gas = 100000;
+    const auto checkpoint = host.checkpoint();
+    BenchOptions bench_options;
+    bench_options.num_samples = 1;
+    bench_options.sample_time = std::chrono::microseconds{100};
+    bench_options.track_allocations = true;
+    const auto r =
+        measure(host, vm, EVMC_CANCUN, msg, code, bench_options, [&] { host.revert(checkpoint); });
+    ASSERT_TRUE(r.allocs.has_value());
+
+    // The VM allocates the output, the host creates the account and the storage slot.
+    EXPECT_GE(r.allocs->vm.num_allocations, 1);
+    EXPECT_GE(r.allocs->vm.bytes_allocated, 32);
+    EXPECT_GE(r.allocs->host.num_allocations, 1);
+    EXPECT_GT(r.allocs->host.bytes_allocated, 0);
+    EXPECT_GE(r.allocs->peak_live_bytes, r.allocs->vm.bytes_allocated);
+}
+
+TEST(host_profiler, counts)
+{
+    using namespace evmc::literals;
+    evmc::MockedHost mocked_host;
+    HostProfiler profiler{16};
+    InstrumentedHost host{mocked_host, profiler};
+
+    for (int i = 0; i < 20; ++i)
+        host.get_storage(0x01_address, 0x01_bytes32);
+    host.set_storage(0x01_address, 0x01_bytes32, 0x01_bytes32);
+    host.get_tx_context();
+
+    const auto& stats = profiler.stats();
+    const auto& get_storage = stats[static_cast<size_t>(HostMethod::get_storage)];
+    EXPECT_EQ(get_storage.num_calls, 20);
+    EXPECT_EQ(get_storage.num_timed_calls, 2);
+    EXPECT_GE(get_storage.mean_latency(), 0);
+    EXPECT_EQ(get_storage.estimated_time(), get_storage.mean_latency() * 20);
+    EXPECT_EQ(stats[static_cast<size_t>(HostMethod::set_storage)].num_calls, 1);
+    EXPECT_EQ(stats[static_cast<size_t>(HostMethod::set_storage)].num_timed_calls, 1);
+    EXPECT_EQ(stats[static_cast<size_t>(HostMethod::get_tx_context)].num_calls, 1);
+    EXPECT_EQ(stats[static_cast<size_t>(HostMethod::call)].num_calls, 0);
+
+    // The calls are forwarded to the wrapped host.
+    EXPECT_EQ(mocked_host.accounts[0x01_address].storage[0x01_bytes32].current, 0x01_bytes32);
+
+    HostProfile profile;
+    profile.methods = stats;
+    profile.num_executions = 2;
+    profile.total_time = profiler.stats()[1].estimated_time() * 4;
+    EXPECT_EQ(profile.calls_per_execution(), 11);
+    EXPECT_GT(profile.host_fraction(), 0);
+    EXPECT_LE(profile.host_fraction(), 1);
+}
+
+TEST(tool_commands, bench_host_profile)
+{
+    // Yul: sstore(0, add(sload(0), 1))
+    const auto code = *from_hex("600054600101600055");
+    auto vm = evmc::VM{evmc_create_example_vm()};
+    std::ostringstream out;
+    std::ostringstream report;
+
+    RunOptions options;
+    options.bench.emplace();
+    options.bench->num_samples = 2;
+    options.bench->sample_time = std::chrono::microseconds{100};
+    options.bench->isolate_state = true;
+    options.bench->profile_host = true;
+    options.bench->report = &report;
+
+    EXPECT_EQ(run(vm, EVMC_CANCUN, 100000, code, {}, options, out), 0);
+    const auto o = out.str();
+    EXPECT_NE(o.find("\nHost:     "), std::string::npos);
+    EXPECT_NE(o.find("% of time in 2.0 callbacks per execution (VM: "), std::string::npos);
+    EXPECT_NE(o.find("\n          get_storage: 1.0 calls, "), std::string::npos);
+    EXPECT_NE(o.find("\n          set_storage: 1.0 calls, "), std::string::npos);
+    EXPECT_EQ(o.find("get_balance"), std::string::npos);
+
+    const auto r = report.str();
+    EXPECT_NE(r.find("\"host\": {\"fraction\": "), std::string::npos);
+    EXPECT_NE(r.find("\"get_storage\": {\"calls_per_execution\": 1, \"mean_latency_ns\": "),
+              std::string::npos);
+}
+
+TEST(file, mapped_file)
+{
+    const auto path = write_temp_file("evmc_mapped_file.bin", {"\x00\xaa\xff\x0a", 4});
+    MappedFile file{path};
+    EXPECT_EQ(evmc::hex(file.data()), "00aaff0a");
+
+    const MappedFile moved{std::move(file)};
+    EXPECT_EQ(evmc::hex(moved.data()), "00aaff0a");
+    EXPECT_TRUE(file.data().empty());  // NOLINT(bugprone-use-after-move)
+
+    EXPECT_TRUE(MappedFile{write_temp_file("evmc_mapped_file.empty", "")}.data().empty());
+    EXPECT_THROW(MappedFile{path + ".missing"}, std::system_error);
+}
+
+TEST(file, load_hex_file)
+{
+    const std::string long_hex =
+        "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+        "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f";
+
+    for (const auto& hex : {std::string{}, std::string{"0x"}, std::string{"  0xaabb\n"},
+                            "0x" + long_hex, long_hex + "\n", " 0 1\t" + long_hex + " ff ",
+                            long_hex.substr(0, 20) + "\n" + long_hex.substr(20) + "\r\n"})
+    {
+        const auto path = write_temp_file("evmc_load_hex_file.hex", hex);
+        EXPECT_EQ(load_hex_file(path), evmc::from_spaced_hex(hex).value()) << hex;
+    }
+
+    for (const auto& hex : {std::string{"a"}, std::string{"0xa"}, long_hex + "f",
+                            long_hex.substr(0, 30) + "x" + long_hex, "00x" + long_hex,
+                            "\xa0" + long_hex, long_hex.substr(0, 30) + "\xa0" + long_hex})
+    {
+        ASSERT_FALSE(evmc::from_spaced_hex(hex));
+        const auto path = write_temp_file("evmc_load_hex_file.hex", hex);
+        EXPECT_THROW(load_hex_file(path), std::invalid_argument) << hex;
+    }
+}
+
+TEST(state, json)
+{
+    using namespace evmc::literals;
+    const auto state = parse_json_state(R"({
+        "0x00000000000000000000000000000000000000aa": {
+            "nonce": "0x07",
+            "balance": 1000,
+            "code": "0x6001",
+            "codehash": "0x01",
+            "storage": {"0x01": "0x02", "0x0003": "0x04"}
+        },
+        "0xbb": {"balance": "0x0100000000000000000000000000000000"}
+    })");
+    ASSERT_EQ(state.size(), 2);
+
+    const auto& a = state.at(0xaa_address);
+    EXPECT_EQ(a.nonce, 7);
+    EXPECT_EQ(a.balance, 0x03e8_bytes32);
+    EXPECT_EQ(evmc::hex(a.code), "6001");
+    EXPECT_EQ(a.codehash, 0x01_bytes32);
+    ASSERT_EQ(a.storage.size(), 2);
+    EXPECT_EQ(a.storage.at(0x01_bytes32).current, 0x02_bytes32);
+    EXPECT_EQ(a.storage.at(0x01_bytes32).original, 0x02_bytes32);
+    EXPECT_EQ(a.storage.at(0x03_bytes32).current, 0x04_bytes32);
+
+    const auto& b = state.at(0xbb_address);
+    EXPECT_EQ(b.balance, 0x0100000000000000000000000000000000_bytes32);
+    EXPECT_EQ(b.nonce, 0);
+    EXPECT_TRUE(b.code.empty());
+    EXPECT_TRUE(b.storage.empty());
+
+    EXPECT_THROW(parse_json_state("[]"), std::invalid_argument);
+    EXPECT_THROW(parse_json_state(R"({"0xzz": {}})"), std::invalid_argument);
+    EXPECT_THROW(parse_json_state(R"({"0x01": 1})"), std::invalid_argument);
+    EXPECT_THROW(parse_json_state(R"({"0x01": {"nonce": -1}})"), std::invalid_argument);
+    EXPECT_THROW(parse_json_state(R"({"0x01": {"nonce": "0x0100000000"}})"), std::invalid_argument);
+    EXPECT_THROW(parse_json_state(R"({"0x01": {"code": "0x1"}})"), std::invalid_argument);
+    EXPECT_THROW(parse_json_state(R"({"0x01": {"storage": {"0x01": 1}}})"), std::invalid_argument);
+}
+
+TEST(state, snapshot)
+{
+    using namespace evmc::literals;
+    State state;
+    for (uint8_t i = 1; i <= 3; ++i)
+    {
+        auto& account = state[evmc::address{i}];
+        account.nonce = i;
+        account.set_balance(i * 1000u);
+        account.code = evmc::bytes(i, i);
+        account.codehash = evmc::bytes32{i};
+        for (uint8_t k = 0; k < i * 10; ++k)
+            account.storage[evmc::bytes32{k}] = evmc::bytes32{uint64_t{k} * i};
+    }
+    state[0xee_address];  // Empty account.
+
+    std::ostringstream out;
+    write_state_snapshot(out, state);
+    const auto str = out.str();
+    const evmc::bytes snapshot{reinterpret_cast<const uint8_t*>(str.data()), str.size()};
+    EXPECT_EQ(snapshot.substr(0, 8), (evmc::bytes{'E', 'V', 'M', 'C', 'S', 'T', 'A', 1}));
+
+    // The snapshot is deterministic.
+    std::ostringstream out2;
+    write_state_snapshot(out2, State{state.begin(), state.end()});
+    EXPECT_EQ(out2.str(), str);
+
+    const auto loaded = load_state_snapshot(snapshot);
+    ASSERT_EQ(loaded.size(), state.size());
+    for (const auto& [addr, account] : state)
+    {
+        const auto& l = loaded.at(addr);
+        EXPECT_EQ(l.nonce, account.nonce);
+        EXPECT_EQ(l.balance, account.balance);
+        EXPECT_EQ(l.code, account.code);
+        EXPECT_EQ(l.codehash, account.codehash);
+        ASSERT_EQ(l.storage.size(), account.storage.size());
+        for (const auto& [key, value] : account.storage)
+            EXPECT_EQ(l.storage.at(key).current, value.current);
+    }
+
+    EXPECT_THROW(load_state_snapshot({}), std::invalid_argument);
+    EXPECT_THROW(load_state_snapshot(snapshot.substr(0, 8)), std::invalid_argument);
+    EXPECT_THROW(load_state_snapshot(snapshot.substr(0, snapshot.size() - 1)),
+                 std::invalid_argument);
+    EXPECT_THROW(load_state_snapshot(snapshot + uint8_t{0}), std::invalid_argument);
+    auto corrupted = snapshot;
+    corrupted[8] = 0xff;  // The number of accounts.
+    EXPECT_THROW(load_state_snapshot(corrupted), std::invalid_argument);
+    corrupted = snapshot;
+    corrupted[16 + 20 + 3] = 0x80;  // The nonce of the first account: 2^31.
+    EXPECT_THROW(load_state_snapshot(corrupted), std::invalid_argument);
+
+    // The first account record: 108 bytes of the fixed fields, 1 byte of code, 10 slots.
+    constexpr size_t first_account = 16;
+    constexpr size_t first_slot = first_account + 108 + 1;
+    constexpr size_t second_account = first_slot + 10 * 64;
+    corrupted = snapshot;
+    corrupted[second_account + 19] = 0x01;  // The address of the second account: 0x01.
+    EXPECT_THROW(load_state_snapshot(corrupted), std::invalid_argument);
+    corrupted = snapshot;
+    corrupted[first_slot + 64 + 31] = 0x00;  // The key of the second slot: 0x00.
+    EXPECT_THROW(load_state_snapshot(corrupted), std::invalid_argument);
+}
+
+TEST(state, load_state)
+{
+    const auto json_path =
+        write_temp_file("evmc_state.json", R"({"0x01": {"storage": {"0x01": "0x02"}}})");
+    const auto state = load_state(json_path);
+    EXPECT_EQ(state.size(), 1);
+
+    std::ostringstream out;
+    write_state_snapshot(out, state);
+    const auto snapshot_path = write_temp_file("evmc_state.snapshot", out.str());
+    const auto loaded = load_state(snapshot_path);
+    ASSERT_EQ(loaded.size(), 1);
+    EXPECT_EQ(loaded.begin()->second.storage.size(), 1);
+}
+
+TEST(tool_commands, run_with_state)
+{
+    using namespace evmc::literals;
+    // Yul: sstore(0, add(sload(0), 1)) mstore(0, sload(0)) return(0, 32)
+    const auto code = *from_hex("60005460010160005560005460005260206000f3");
+    auto vm = evmc::VM{evmc_create_example_vm()};
+    State state;
+    state[evmc::address{}].storage[0x00_bytes32] = 0x29_bytes32;
+
+    RunOptions options;
+    options.state = &state;
+    std::ostringstream out;
+    EXPECT_EQ(run(vm, EVMC_CANCUN, 100000, code, {}, options, out), 0);
+    EXPECT_NE(out.str().find("Output:   " + std::string(62, '0') + "2a\n"), std::string::npos)
+        << out.str();
+}
+
+namespace
+{
+template <typename T>
+void put_le(std::string& out, T v)
+{
+    for (size_t i = 0; i < sizeof(T); ++i)
+        out.push_back(static_cast<char>(static_cast<uint64_t>(v) >> (8 * i)));
+}
+
+void put_le_bytes(std::string& out, std::string_view v)
+{
+    put_le(out, static_cast<uint32_t>(v.size()));
+    out.append(v);
+}
+
+/// Encodes the serve() request frame.
+std::string serve_request(uint64_t id,
+                          uint32_t rev,
+                          int64_t gas,
+                          const evmc::bytes& code,
+                          const evmc::bytes& input = {},
+                          const std::string& state_path = {})
+{
+    std::string frame;
+    put_le(frame, id);
+    put_le(frame, rev);
+    put_le(frame, gas);
+    put_le_bytes(frame, {reinterpret_cast<const char*>(code.data()), code.size()});
+    put_le_bytes(frame, {reinterpret_cast<const char*>(input.data()), input.size()});
+    put_le_bytes(frame, state_path);
+    std::string out;
+    put_le(out, static_cast<uint32_t>(frame.size()));
+    return out + frame;
+}
+
+/// The decoded serve() response frame.
+struct ServeResponse
+{
+    uint64_t id = 0;
+    int32_t status = 0;
+    int64_t gas_left = 0;
+    int64_t gas_refund = 0;
+    std::string output;
+};
+
+std::vector<ServeResponse> parse_serve_responses(std::string_view in)
+{
+    const auto get = [&in](size_t size) {
+        EXPECT_GE(in.size(), size);
+        uint64_t v = 0;
+        for (size_t i = 0; i < size; ++i)
+            v |= uint64_t{static_cast<uint8_t>(in[i])} << (8 * i);
+        in.remove_prefix(size);
+        return v;
+    };
+
+    std::vector<ServeResponse> responses;
+    while (!in.empty())
+    {
+        const auto frame_size = get(4);
+        const auto expected_rest = in.size() - frame_size;
+        ServeResponse r;
+        r.id = get(8);
+        r.status = static_cast<int32_t>(get(4));
+        r.gas_left = static_cast<int64_t>(get(8));
+        r.gas_refund = static_cast<int64_t>(get(8));
+        r.output = std::string{in.substr(0, get(4))};
+        in.remove_prefix(r.output.size());
+        EXPECT_EQ(in.size(), expected_rest);
+        responses.push_back(std::move(r));
+    }
+    return responses;
+}
+}  // namespace
+
+TEST(serve, requests)
+{
+    // Yul: sstore(0, add(sload(0), 1)) mstore(0, sload(0)) return(0, 32)
+    const auto increment = *from_hex("60005460010160005560005460005260206000f3");
+    const auto state_path =
+        write_temp_file("evmc_serve_state.json", R"({"0x00": {"storage": {"0x00": "0x29"}}})");
+
+    std::string requests;
+    requests += serve_request(1, EVMC_CANCUN, 100000, *from_hex("600035600052596000f3"),
+                              *from_hex("aabbccdd"));
+    requests += serve_request(2, EVMC_CANCUN, 100000, increment, {}, state_path);
+    requests += serve_request(3, EVMC_CANCUN, 100000, increment, {}, state_path);
+    requests += serve_request(4, EVMC_CANCUN, 100000, increment);
+    requests += serve_request(5, EVMC_MAX_REVISION + 1, 100000, increment);
+    requests += serve_request(6, EVMC_CANCUN, 100000, increment, {}, state_path + ".missing");
+
+    auto vm = evmc::VM{evmc_create_example_vm()};
+    std::istringstream in{requests};
+    std::ostringstream out;
+    EXPECT_EQ(serve(vm, in, out), 6);
+
+    const auto responses = parse_serve_responses(out.str());
+    ASSERT_EQ(responses.size(), 6);
+    for (size_t i = 0; i < responses.size(); ++i)
+        EXPECT_EQ(responses[i].id, i + 1);
+
+    EXPECT_EQ(responses[0].status, EVMC_SUCCESS);
+    EXPECT_EQ(responses[0].gas_left, 100000 - 7);
+    EXPECT_EQ(evmc::hex({reinterpret_cast<const uint8_t*>(responses[0].output.data()),
+                         responses[0].output.size()}),
+              "aabbccdd" + std::string(56, '0'));
+
+    // Every execution starts from the loaded state.
+    EXPECT_EQ(responses[1].status, EVMC_SUCCESS);
+    EXPECT_EQ(static_cast<uint8_t>(responses[1].output.back()), 0x2a);
+    EXPECT_EQ(static_cast<uint8_t>(responses[2].output.back()), 0x2a);
+    EXPECT_EQ(static_cast<uint8_t>(responses[3].output.back()), 0x01);
+
+    EXPECT_EQ(responses[4].status, EVMC_REJECTED);
+    EXPECT_EQ(responses[4].output, "unknown revision " + std::to_string(EVMC_MAX_REVISION + 1));
+    EXPECT_EQ(responses[5].status, EVMC_REJECTED);
+    EXPECT_NE(responses[5].output.find(".missing"), std::string::npos);
+}
+
+TEST(serve, malformed)
+{
+    auto vm = evmc::VM{evmc_create_example_vm()};
+    const auto request = serve_request(1, EVMC_CANCUN, 1000, *from_hex("00"));
+
+    std::istringstream empty_in;
+    std::ostringstream out;
+    EXPECT_EQ(serve(vm, empty_in, out), 0);
+    EXPECT_TRUE(out.str().empty());
+
+    // The valid requests before the malformed one are served.
+    std::istringstream truncated_in{request + request.substr(0, request.size() - 1)};
+    EXPECT_THROW(serve(vm, truncated_in, out), std::invalid_argument);
+    EXPECT_EQ(parse_serve_responses(out.str()).size(), 1);
+
+    std::istringstream truncated_size_in{request.substr(0, 2)};
+    EXPECT_THROW(serve(vm, truncated_size_in, out), std::invalid_argument);
+
+    auto trailing = request;
+    trailing[0] = static_cast<char>(trailing[0] + 1);
+    trailing += '\0';
+    std::istringstream trailing_in{trailing};
+    EXPECT_THROW(serve(vm, trailing_in, out), std::invalid_argument);
+
+    // The frame size is checked before the frame buffer is allocated.
+    std::istringstream too_large_in{std::string{"\xff\xff\xff\xff"} + request};
+    try
+    {
+        serve(vm, too_large_in, out);
+        ADD_FAILURE() << "expected exception";
+    }
+    catch (const std::invalid_argument& e)
+    {
+        EXPECT_STREQ(e.what(), "malformed request: frame too large");
+    }
+}
+
+#ifdef __linux__
+namespace
+{
+/// Connects to the Unix domain socket, waiting for the server to start listening.
+int connect_unix_socket(const std::string& path)
+{
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, path.c_str());
+    const auto fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    while (fd >= 0 && ::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    return fd;
+}
+}  // namespace
+
+TEST(serve, unix_socket)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "evmc_serve_test.sock").string();
+    std::filesystem::remove(path);
+
+    auto vm = evmc::VM{evmc_create_example_vm()};
+    std::thread server{[&vm, &path] { serve_unix_socket(vm, path, 1); }};
+
+    const auto fd = connect_unix_socket(path);
+    ASSERT_GE(fd, 0);
+
+    const auto request = serve_request(7, EVMC_CANCUN, 1000, *from_hex("600035600052596000f3"),
+                                       *from_hex("01"));
+    ASSERT_EQ(::write(fd, request.data(), request.size()), static_cast<ssize_t>(request.size()));
+    ::shutdown(fd, SHUT_WR);
+
+    std::string response;
+    std::array<char, 256> buffer{};
+    for (ssize_t n = 0; (n = ::read(fd, buffer.data(), buffer.size())) > 0;)
+        response.append(buffer.data(), static_cast<size_t>(n));
+    ::close(fd);
+    server.join();
+
+    const auto responses = parse_serve_responses(response);
+    ASSERT_EQ(responses.size(), 1);
+    EXPECT_EQ(responses[0].id, 7);
+    EXPECT_EQ(responses[0].status, EVMC_SUCCESS);
+    EXPECT_EQ(static_cast<uint8_t>(responses[0].output[0]), 0x01);
+    EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST(serve, unix_socket_execution_error)
+{
+    const auto path =
+        (std::filesystem::temp_directory_path() / "evmc_serve_error_test.sock").string();
+    std::filesystem::remove(path);
+
+    // The VM returning the output too big for the response frame to be allocated,
+    // so the executor fails with an exception.
+    evmc_vm raw{EVMC_ABI_VERSION, "", "", nullptr, nullptr, nullptr, nullptr};
+    raw.destroy = [](evmc_vm*) {};
+    raw.execute = [](evmc_vm*, const evmc_host_interface*, evmc_host_context*, evmc_revision,
+                     const evmc_message*, const uint8_t* code, size_t) {
+        evmc_result result{};
+        result.output_data = code;
+        result.output_size = std::numeric_limits<size_t>::max() / 2 + 1;
+        return result;
+    };
+    auto vm = evmc::VM{&raw};
+
+    std::exception_ptr server_error;
+    std::thread server{[&] {
+        try
+        {
+            serve_unix_socket(vm, path, 1);
+        }
+        catch (...)
+        {
+            server_error = std::current_exception();
+        }
+    }};
+
+    const auto fd = connect_unix_socket(path);
+    ASSERT_GE(fd, 0);
+    const auto request = serve_request(1, EVMC_CANCUN, 1000, *from_hex("00"));
+    ASSERT_EQ(::write(fd, request.data(), request.size()), static_cast<ssize_t>(request.size()));
+
+    // The server stops reading the connection which is still open.
+    server.join();
+    ::close(fd);
+    std::filesystem::remove(path);
+    EXPECT_TRUE(server_error);
+}
+#endif
+
+TEST(diff, executions)
+{
+    using namespace evmc::literals;
+    auto vm = evmc::VM{evmc_create_example_vm()};
+    auto precompiles_vm = evmc::VM{evmc_create_example_precompiles_vm()};
+
+    evmc::FlatMockedHost state;
+    state.accounts[{}].storage[0x01_bytes32] = 0x01_bytes32;
+    evmc_message msg{};
+    msg.gas = 1000;
+
+    // Yul: sstore(0, 1)
+    const auto code = *from_hex("600160005500");
+    EXPECT_TRUE(diff_executions(vm, vm, EVMC_CANCUN, msg, code, state).empty());
+
+    const auto diffs = diff_executions(vm, precompiles_vm, EVMC_CANCUN, msg, code, state);
+    ASSERT_EQ(diffs.size(), 2);
+    EXPECT_EQ(diffs[0], "gas_left: 996 vs 1000");
+    EXPECT_EQ(diffs[1], "storage 0x" + std::string(40, '0') + "[0x" + std::string(64, '0') +
+                            "]: 0x" + std::string(63, '0') + "1 vs 0x" + std::string(64, '0'));
+
+    // The state is not modified.
+    EXPECT_EQ(state.accounts[{}].storage.size(), 1);
+}
+
+TEST(tool_commands, run_diff)
+{
+    auto vm = evmc::VM{evmc_create_example_vm()};
+    auto precompiles_vm = evmc::VM{evmc_create_example_precompiles_vm()};
+    const auto code = *from_hex("600035600052596000f3");
+    const auto input = *from_hex("aa");
+
+    RunOptions options;
+    options.bench.emplace();
+    options.bench->warmup_iterations = 0;
+    options.bench->num_samples = 2;
+    options.bench->sample_time = std::chrono::microseconds{100};
+
+    std::ostringstream out;
+    EXPECT_EQ(run_diff(vm, vm, EVMC_CANCUN, 1000, code, input, options, out), 0);
+    EXPECT_NE(out.str().find("\nRatio:    "), std::string::npos);
+    EXPECT_NE(out.str().find("\nResult:   success\nGas used: 7\nOutput:   aa"), std::string::npos);
+    EXPECT_NE(out.str().find("\nDiff:     identical\n"), std::string::npos);
+
+    std::ostringstream out2;
+    EXPECT_EQ(run_diff(vm, precompiles_vm, EVMC_CANCUN, 1000, code, input, options, out2), 1);
+    EXPECT_NE(out2.str().find("\nDiff:     2 differences ([1] vs [2])\n"
+                              "          gas_left: 993 vs 1000\n"
+                              "          output: aa"),
+              std::string::npos)
+        << out2.str();
+
+    options.create = true;
+    EXPECT_THROW(run_diff(vm, vm, EVMC_CANCUN, 1000, code, input, options, out),
+                 std::invalid_argument);
+}
+
+TEST(benchgen, generate)
+{
+    BenchGenOptions options;
+    options.rev = EVMC_CANCUN;
+    options.gas_limit = 100000;
+    options.size = 1024;
+    const auto cases = generate_bench_corpus(options);
+
+    std::vector<std::string> names;
+    for (const auto& c : cases)
+    {
+        names.push_back(c.name);
+        ASSERT_TRUE(c.expected_gas.has_value());
+        EXPECT_LE(*c.expected_gas, options.gas_limit);
+        EXPECT_TRUE(c.input.empty());
+    }
+    EXPECT_EQ(names, (std::vector<std::string>{"arith", "call", "keccak256", "log2", "memory",
+                                               "return_data", "storage_cold", "storage_hot"}));
+
+    // 2 * PUSH + n * (JUMPDEST + 6 body instructions + 6 loop instructions), n = 2173.
+    EXPECT_EQ(*cases[0].expected_gas, 6 + 2173 * 46);
+    // PUSH + 2 * PUSH + RETURN + memory expansion of 32 words.
+    EXPECT_EQ(evmc::hex(cases[5].code), "6104006000f3");
+    EXPECT_EQ(*cases[5].expected_gas, 6 + 32 * 3 + 32 * 32 / 512);
+    // PUSH + n * (JUMPDEST + 6 body + 6 loop instructions + cold SLOAD + SSTORE set), n = 4.
+    EXPECT_EQ(*cases[6].expected_gas, 3 + 4 * (1 + 112 + 25 + 2000 + 20000));
+
+    options.max_iterations = 1;
+    const auto single = generate_bench_corpus(options);
+    EXPECT_EQ(*single[0].expected_gas, 6 + 46);
+    EXPECT_EQ(evmc::hex(single[0].code), "600160015b90800260030190600190038060045700");
+
+    options.gas_limit = 1000;  // Too low for the storage programs.
+    EXPECT_THROW(generate_bench_corpus(options), std::invalid_argument);
+    options.gas_limit = 100000;
+    options.rev = EVMC_ISTANBUL;
+    EXPECT_THROW(generate_bench_corpus(options), std::invalid_argument);
+}
+
+TEST(benchgen, save_and_load_corpus)
+{
+    const auto dir = (std::filesystem::temp_directory_path() / "evmc_benchgen_corpus").string();
+    std::filesystem::remove_all(dir);
+    const std::vector<BenchCase> cases{
+        {"a", *from_hex("6001"), {}, 6},
+        {"b", *from_hex("00"), *from_hex("aabb"), std::nullopt},
+    };
+    save_corpus(dir, cases);
+    const auto loaded = load_corpus(dir);
+    ASSERT_EQ(loaded.size(), 2);
+    EXPECT_EQ(loaded[0].name, "a");
+    EXPECT_EQ(loaded[0].code, cases[0].code);
+    EXPECT_TRUE(loaded[0].input.empty());
+    EXPECT_EQ(loaded[0].expected_gas, 6);
+    EXPECT_EQ(loaded[1].name, "b");
+    EXPECT_EQ(loaded[1].input, cases[1].input);
+    EXPECT_FALSE(loaded[1].expected_gas.has_value());
+
+    std::ofstream{dir + "/a.gas"} << "6x";
+    EXPECT_THROW(load_corpus(dir), std::invalid_argument);
+}
+
+TEST(tool_commands, bench_corpus_expected_gas)
+{
+    std::vector<std::pair<std::string, evmc::VM>> vms;
+    vms.emplace_back("vm", evmc::VM{evmc_create_example_vm()});
+    const std::vector<BenchCase> cases{
+        {"ok", *from_hex("6001"), {}, 1},  // The example VM charges 1 gas per instruction.
+        {"wrong", *from_hex("6001"), {}, 3},
+    };
+
+    CorpusBenchOptions options;
+    options.bench.warmup_iterations = 0;
+    options.bench.num_samples = 1;
+    options.bench.sample_time = std::chrono::microseconds{100};
+    std::ostringstream out;
+    EXPECT_EQ(bench_corpus(vms, cases, EVMC_CANCUN, 1000, options, out), 0);
+    EXPECT_EQ(out.str().find("WARNING! ok"), std::string::npos);
+    EXPECT_NE(out.str().find("WARNING! wrong [1]: gas used 1, expected 3\n"), std::string::npos);
+}
@@ -0,0 +1,254 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <evmc/uint256.hpp>
+#include <gtest/gtest.h>
+#include <random>
+
+using evmc::uint256;
+using namespace evmc::literals;
+
+namespace
+{
+constexpr auto max = ~uint256{};
+
+/// Generates the value from the random 64-bit limbs, some of them replaced by special values.
+uint256 random_value(std::mt19937_64& rng)
+{
+    constexpr uint64_t special[]{0, 1, 0xffffffff, 0x80000000, 0xffffffff00000000,
+                                 0x8000000000000000, ~uint64_t{0}};
+    uint256 x;
+    const auto num_words = rng() % 4 + 1;
+    for (size_t i = 0; i < num_words; ++i)
+        x[i] = rng() % 4 == 0 ? special[rng() % std::size(special)] : rng();
+    return x;
+}
+}  // namespace
+
+TEST(uint256, construction)
+{
+    static_assert(uint256{} == 0);
+    static_assert(uint256{7}[0] == 7);
+    static_assert(uint256{1, 2, 3, 4}[0] == 4);
+    static_assert(uint256{1, 2, 3, 4}[3] == 1);
+    static_assert(!uint256{});
+    static_assert(static_cast<bool>(uint256{0, 1, 0, 0}));
+    static_assert(static_cast<uint64_t>(uint256{1, 2, 3, 4}) == 4);
+}
+
+TEST(uint256, bytes_conversion)
+{
+    constexpr auto be = 0x0102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20_bytes32;
+    constexpr auto x = uint256{be};
+    static_assert(x[3] == 0x0102030405060708);
+    static_assert(x[0] == 0x191a1b1c1d1e1f20);
+    static_assert(static_cast<evmc::uint256be>(x) == be);
+
+    const auto y = uint256{be};
+    EXPECT_EQ(y, x);
+    EXPECT_EQ(static_cast<evmc::uint256be>(y), be);
+    EXPECT_EQ(static_cast<evmc::uint256be>(uint256{0xfe}), 0xfe_bytes32);
+}
+
+TEST(uint256, literals)
+{
+    static_assert(0_u256 == 0);
+    static_assert(0x0_u256 == 0);
+    static_assert(1234567890_u256 == 1234567890);
+    static_assert(0xabc_u256 == 0xabc);
+    static_assert(340282366920938463463374607431768211456_u256 == uint256{0, 1, 0, 0});
+    static_assert(0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff_u256 == max);
+    static_assert(
+        115792089237316195423570985008687907853269984665640564039457584007913129639935_u256 ==
+        max);
+
+    EXPECT_EQ(evmc::parse_uint256("18446744073709551616"), (uint256{0, 0, 1, 0}));
+    EXPECT_EQ(evmc::parse_uint256("0x10000000000000000"), (uint256{0, 0, 1, 0}));
+    EXPECT_FALSE(evmc::parse_uint256(""));
+    EXPECT_FALSE(evmc::parse_uint256("0x"));
+    EXPECT_FALSE(evmc::parse_uint256("12a"));
+    EXPECT_FALSE(evmc::parse_uint256("0xg"));
+    EXPECT_FALSE(evmc::parse_uint256("-1"));
+    EXPECT_FALSE(evmc::parse_uint256(
+        "115792089237316195423570985008687907853269984665640564039457584007913129639936"));
+    EXPECT_FALSE(evmc::parse_uint256(
+        "0x1ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"));
+}
+
+TEST(uint256, comparison)
+{
+    static_assert(uint256{1} < uint256{2});
+    static_assert(uint256{1, 0, 0, 0} > uint256{0, ~uint64_t{0}, ~uint64_t{0}, ~uint64_t{0}});
+    static_assert(uint256{5} <= uint256{5});
+    static_assert(uint256{5} >= uint256{5});
+    static_assert(uint256{5} != uint256{6});
+    EXPECT_LT(uint256(0, 0, 1, 0), uint256(0, 0, 1, 1));
+    EXPECT_GT(max, uint256{});
+    EXPECT_FALSE(max < max);
+}
+
+TEST(uint256, arithmetic)
+{
+    struct TestCase
+    {
+        uint256 x;
+        uint256 y;
+        uint256 sum;
+        uint256 diff;
+        uint256 prod;
+    };
+    constexpr TestCase test_cases[]{
+        {0xd23f0824128b2f330c5c7fd0a6a3a4506513270e269e0d37f2a74de452e6b438_u256,
+         0xb6f675cc81e74ef5e8e25d940ed904759531985d5d9dc9f81818e811892f902b_u256,
+         0x89357df094727e28f53edd64b57ca8c5fa44bf6b843bd7300ac035f5dc164463_u256,
+         0x1b48925790a3e03d237a223c97ca9fdacfe18eb0c900433fda8e65d2c9b7240d_u256,
+         0x65f99d1ee00db3dc2ae0851bd5090f341bd44e608453d25b1517ea80c067c568_u256},
+        {0x8d116ece1738f7d93d9c172411e20b8f6b0d549b6f03675a1600a35a099950d8_u256,
+         0x90c192cfd3ac94af0f21ddb66cad4a26_u256,
+         0x8d116ece1738f7d93d9c172411e20b8ffbcee76b42affc092522811076469afe_u256,
+         0x8d116ece1738f7d93d9c172411e20b8eda4bc1cb9b56d2ab06dec5a39cec06b2_u256,
+         0x9187ec87f7009b84022ae6df70baef79fa0d282761d9bd8814d7626a80187010_u256},
+        {0xa217beaddbc496cb8e81973e0becd7b03898d190f9ebdacc0cb1e29c658cda14_u256,
+         0x14a23d596_u256,
+         0xa217beaddbc496cb8e81973e0becd7b03898d190f9ebdacc0cb1e29dafb0afaa_u256,
+         0xa217beaddbc496cb8e81973e0becd7b03898d190f9ebdacc0cb1e29b1b69047e_u256,
+         0xeaa0d7fc5a2f4184fba02db1b248bb61d8e49e2d9f81048f08105b814ab66bb8_u256},
+        {max, 1, 0, max - 1, max},
+        {0, 1, 1, max, 0},
+    };
+    static_assert(test_cases[0].x + test_cases[0].y == test_cases[0].sum);
+    static_assert(test_cases[0].x * test_cases[0].y == test_cases[0].prod);
+
+    for (const auto& t : test_cases)
+    {
+        EXPECT_EQ(t.x + t.y, t.sum);
+        EXPECT_EQ(t.y + t.x, t.sum);
+        EXPECT_EQ(t.x - t.y, t.diff);
+        EXPECT_EQ(t.sum - t.y, t.x);
+        EXPECT_EQ(t.x * t.y, t.prod);
+        EXPECT_EQ(t.y * t.x, t.prod);
+        auto z = t.x;
+        z += t.y;
+        z -= t.y;
+        EXPECT_EQ(z, t.x);
+    }
+    EXPECT_EQ(-uint256{1}, max);
+    EXPECT_EQ(-uint256{}, 0);
+    EXPECT_EQ(max * max, 1);
+}
+
+TEST(uint256, division)
+{
+    struct TestCase
+    {
+        uint256 x;
+        uint256 y;
+        uint256 quot;
+        uint256 rem;
+    };
+    constexpr TestCase test_cases[]{
+        {0xd23f0824128b2f330c5c7fd0a6a3a4506513270e269e0d37f2a74de452e6b438_u256,
+         0xb6f675cc81e74ef5e8e25d940ed904759531985d5d9dc9f81818e811892f902b_u256, 1,
+         0x1b48925790a3e03d237a223c97ca9fdacfe18eb0c900433fda8e65d2c9b7240d_u256},
+        {0x8d116ece1738f7d93d9c172411e20b8f6b0d549b6f03675a1600a35a099950d8_u256,
+         0x90c192cfd3ac94af0f21ddb66cad4a26_u256, 0xf97a4b9ddfd56ea6e4688a8a10b3aadd_u256,
+         0x5a57d3da826c59a4245dd269ec31120a_u256},
+        {0x8fd630f1f29d0da9953f48f1a09f76b5a170b33839263059f28c105d1fb17c23_u256,
+         0x95e60af593bd04cf_u256,
+         0xf5a5b70e5ed44fb183822b935d9023bf053015608a37c0b3_u256, 0x3fccd057072df66_u256},
+        {0xa217beaddbc496cb8e81973e0becd7b03898d190f9ebdacc0cb1e29c658cda14_u256,
+         0x14a23d596_u256, 0x7db0fd5fa878a231e1028d89e00cd90073f0d3b61650dfca8a68320f_u256,
+         0x6ccc0a4a_u256},
+        {0xd08f6d05584ef8aa38922766581e27a1c08a6a63ec24ede6a4_u256,
+         0x294e3bf911a61dbe22e44158bae97ba94_u256, 0x50c986280b57284974_u256,
+         0x5a22a4e6e6248eaa401ecf5e50d92794_u256},
+        {0x907a70c31012f037b64ce4228c38fb2918f135d25f557203301850c5a38fd547_u256,
+         0x31be1dc6d76b07e881ed162ae2eb1547f15052434b9b5df9e7769b10f4205b4_u256, 0x2e,
+         0x177db2764bf397b40c344673fd51dfa432a4950e5f6c3d4b6a352f4e5b2ceef_u256},
+        {0xf731af10506bf2ef_u256,
+         0xcb3f98e2774cbd87ad5c90a9587403e430ec66a78795e761d1_u256, 0,
+         0xf731af10506bf2ef_u256},
+        {0xa6e875555790f82ec1d3fcff2a3af4d46b0a18e8830e07bc1e398f1012bd4ace_u256,
+         0xeeeacbe2_u256, 0xb2d7966a80aa14157452bc70887f90d33bb2be12a51a633584ab50b1_u256,
+         0xcab9b38c_u256},
+        {0x8ede0d7ac3baea9e13deef86ab1031d0f646e1f40a097c976bf46c697d2caf82_u256,
+         0xe01f5057ca02135e92b1d3f2_u256, 0xa3301ac9bea3e32bc8d183900b1681c029755f53_u256,
+         0x15cab7bfea689e9850442a0c_u256},
+        {0x7fffffff800000010000000000000000_u256, 0x800000008000000200000005_u256,
+         0xfffffffd_u256, 0x80000000800000010000000f_u256},
+        {max, max, 1, 0},
+        {max, 1, max, 0},
+        {123, 0, 0, 0},
+    };
+    static_assert(test_cases[1].x / test_cases[1].y == test_cases[1].quot);
+    static_assert(test_cases[1].x % test_cases[1].y == test_cases[1].rem);
+
+    for (const auto& t : test_cases)
+    {
+        EXPECT_EQ(t.x / t.y, t.quot);
+        EXPECT_EQ(t.x % t.y, t.rem);
+    }
+}
+
+TEST(uint256, division_random)
+{
+    // Check the division identity on values with special limbs likely to trigger
+    // the quotient digit corrections of the long division.
+    std::mt19937_64 rng{256};
+    for (int i = 0; i < 10000; ++i)
+    {
+        const auto x = random_value(rng);
+        const auto y = random_value(rng);
+        if (!y)
+            continue;
+        const auto [q, r] = evmc::udivrem(x, y);
+        EXPECT_LT(r, y);
+        EXPECT_EQ(q * y + r, x);
+        // Check the quotient is not too small: (q + 1) * y must exceed x or overflow.
+        const auto next = (q + 1) * y;
+        EXPECT_TRUE(next > x || next / y != q + 1 || next < y);
+    }
+}
+
+TEST(uint256, bitwise)
+{
+    constexpr auto x = 0xff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00_u256;
+    constexpr auto y = 0x0ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff0_u256;
+    static_assert((x & y) ==
+                  0x0f000f000f000f000f000f000f000f000f000f000f000f000f000f000f000f00_u256);
+    static_assert((x | y) ==
+                  0xfff0fff0fff0fff0fff0fff0fff0fff0fff0fff0fff0fff0fff0fff0fff0fff0_u256);
+    static_assert((x ^ y) ==
+                  0xf0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0f0_u256);
+    static_assert(~x == 0x00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff00ff_u256);
+}
+
+TEST(uint256, shifts)
+{
+    constexpr auto x = 0x8000000000000000000000000000000000000000000000000000000000000001_u256;
+    static_assert((x << 1) == 2);
+    static_assert((x >> 255) == 1);
+    static_assert((uint256{1} << 64) == uint256{0, 0, 1, 0});
+    static_assert((uint256{1} << 255) == uint256{0x8000000000000000, 0, 0, 0});
+
+    for (uint64_t s = 0; s < 256; ++s)
+    {
+        const auto one = uint256{1} << s;
+        EXPECT_EQ(one >> s, 1) << s;
+        EXPECT_EQ(max << s >> s, max >> s) << s;
+        EXPECT_EQ(max >> s << s, max << s) << s;
+        EXPECT_EQ(one * 2, uint256{1} << (s + 1)) << s;
+        EXPECT_EQ(x << uint256{s}, x << s) << s;
+        EXPECT_EQ(x >> uint256{s}, x >> s) << s;
+    }
+    EXPECT_EQ(max << 256, 0);
+    EXPECT_EQ(max >> 256, 0);
+    EXPECT_EQ(max << (uint256{0, 0, 1, 0}), 0);
+    EXPECT_EQ(max >> (uint256{0, 0, 1, 0}), 0);
+
+    auto y = x;
+    y <<= 4;
+    y >>= 4;
+    EXPECT_EQ(y, 1);
+}
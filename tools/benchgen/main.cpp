@@ -0,0 +1,65 @@
+// EVMC: Ethereum Client-VM Connector API.
+// Copyright 2026 The EVMC Authors.
+// Licensed under the Apache License, Version 2.0.
+
+#include <CLI/CLI.hpp>
+#include <evmc/tooling.hpp>
+#include <iostream>
+
+int main(int argc, const char** argv) noexcept
+{
+    using namespace evmc;
+
+    try
+    {
+        std::string output_dir;
+        tooling::BenchGenOptions options;
+
+        CLI::App app{"EVMC synthetic benchmark corpus generator"};
+        app.add_option("output", output_dir, "Output directory of the corpus (see evmc bench)")
+            ->required();
+        app.add_option("--rev", options.rev, "EVM revision of the gas costs")
+            ->capture_default_str();
+        app.add_option("--gas", options.gas_limit, "Gas limit every program must fit into")
+            ->capture_default_str()
+            ->check(CLI::Range(int64_t{1}, int64_t{1000000000}));
+        app.add_option("--max-iterations", options.max_iterations,
+                       "Maximum number of loop iterations of a program")
+            ->capture_default_str()
+            ->check(CLI::PositiveNumber);
+        app.add_option("--size", options.size,
+                       "Size in bytes of the memory region, hashed, logged and returned data")
+            ->capture_default_str()
+            ->check(CLI::Range(0, 1 << 24));
+
+        try
+        {
+            app.parse(argc, argv);
+
+            const auto cases = tooling::generate_bench_corpus(options);
+            tooling::save_corpus(output_dir, cases);
+
+            std::cout << "Generated " << cases.size() << " cases in " << output_dir << " ("
+                      << options.rev << ", " << options.gas_limit << " gas limit)\n";
+            for (const auto& c : cases)
+            {
+                std::cout << "  " << c.name << ": " << c.code.size() << " bytes, "
+                          << *c.expected_gas << " gas\n";
+            }
+            return 0;
+        }
+        catch (const CLI::ParseError& e)
+        {
+            return app.exit(e);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return -1;
+    }
+    catch (...)
+    {
+        return -2;
+    }
+}
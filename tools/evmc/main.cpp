@@ -7,33 +7,47 @@
 #include <evmc/loader.h>
 #include <evmc/tooling.hpp>
 #include <fstream>
+#include <iostream>
+#include <optional>
+#include <vector>
 
 namespace
 {
-/// If the argument starts with @ returns the hex-decoded contents of the file
-/// at the path following the @. Otherwise, returns the argument.
-/// @todo The file content is expected to be a hex string but not validated.
-evmc::bytes load_from_hex(const std::string& str)
+/// The bytes loaded from a command-line argument.
+class BytesArg
 {
-    if (str[0] == '@')  // The argument is file path.
+    std::optional<evmc::tooling::MappedFile> m_file;
+    evmc::bytes m_decoded;
+
+public:
+    /// Loads the bytes from the argument:
+    /// - @bin:FILE: the raw contents of the file (memory-mapped, not copied),
+    /// - @FILE: the hex-decoded contents of the file (the whitespace is ignored),
+    /// - otherwise the hex-decoded argument.
+    explicit BytesArg(const std::string& str)
     {
-        const auto path = str.substr(1);
-        std::ifstream file{path};
-        auto out = evmc::from_spaced_hex(std::istreambuf_iterator<char>{file},
-                                         std::istreambuf_iterator<char>{});
-        if (!out)
-            throw std::invalid_argument{"invalid hex in " + path};
-        return out.value();
+        if (str.rfind(bin_file_prefix, 0) == 0)
+            m_file.emplace(str.substr(bin_file_prefix.size()));
+        else if (!str.empty() && str[0] == '@')
+            m_decoded = evmc::tooling::load_hex_file(str.substr(1));
+        else
+            m_decoded = evmc::from_hex(str).value();  // Should be validated already.
     }
 
-    return evmc::from_hex(str).value();  // Should be validated already.
-}
+    /// The loaded bytes. Valid as long as the object is alive.
+    evmc::bytes_view view() const noexcept { return m_file ? m_file->data() : m_decoded; }
+
+    /// The argument prefix of the raw binary file path.
+    static constexpr std::string_view bin_file_prefix = "@bin:";
+};
 
 struct HexOrFileValidator : public CLI::Validator
 {
-    HexOrFileValidator() : CLI::Validator{"HEX|@FILE"}
+    HexOrFileValidator() : CLI::Validator{"HEX|@FILE|@bin:FILE"}
     {
         func_ = [](const std::string& str) -> std::string {
+            if (str.rfind(BytesArg::bin_file_prefix, 0) == 0)
+                return CLI::ExistingFile(str.substr(BytesArg::bin_file_prefix.size()));
             if (!str.empty() && str[0] == '@')
                 return CLI::ExistingFile(str.substr(1));
             if (!evmc::validate_hex(str))
@@ -52,18 +66,36 @@ int main(int argc, const char** argv) noexcept
     {
         const HexOrFileValidator HexOrFile;
 
-        std::string vm_config;
+        std::vector<std::string> vm_configs;
         std::string code_arg;
         int64_t gas = 1000000;
         auto rev = EVMC_LATEST_STABLE_REVISION;
         std::string input_arg;
         auto create = false;
         auto bench = false;
+        tooling::BenchOptions bench_options;
+        int64_t bench_sample_time_ms = 30;
+        std::string bench_report_file;
+        std::string bench_report_format = "json";
+        std::string record_file;
+        std::string replay_file;
+        std::string state_file;
+        std::string snapshot_in_file;
+        std::string snapshot_out_file;
+        std::string socket_path;
+        std::string corpus_dir;
+        tooling::CorpusBenchOptions corpus_options;
+        double corpus_threshold_pct = 5;
+        std::string corpus_baseline_file;
+        std::string corpus_save_file;
 
         CLI::App app{"EVMC tool"};
         const auto& version_flag = *app.add_flag("--version", "Print version information and exit");
         const auto& vm_option =
-            *app.add_option("--vm", vm_config, "EVMC VM module")->envname("EVMC_VM");
+            *app.add_option("--vm", vm_configs,
+                            "EVMC VM module (repeatable: run command compares two VMs)")
+                 ->envname("EVMC_VM")
+                 ->allow_extra_args(false);
 
         auto& run_cmd = *app.add_subcommand("run", "Execute EVM bytecode")->fallthrough();
         run_cmd.add_option("code", code_arg, "Bytecode")->required()->check(HexOrFile);
@@ -77,17 +109,125 @@ int main(int argc, const char** argv) noexcept
             "Create new contract out of the code and then execute this contract with the input");
         run_cmd.add_flag(
             "--bench", bench,
-            "Benchmark execution time (state modification may result in unexpected behaviour)");
+            "Benchmark execution time (state modification may result in unexpected behaviour, "
+            "see --bench-isolate)");
+        run_cmd.add_flag("--bench-isolate", bench_options.isolate_state,
+                         "Restore the state after every benchmark execution");
+        run_cmd.add_option("--bench-warmup", bench_options.warmup_iterations,
+                           "Number of benchmark warm-up executions")
+            ->capture_default_str()
+            ->check(CLI::NonNegativeNumber);
+        run_cmd.add_option("--bench-samples", bench_options.num_samples,
+                           "Number of benchmark samples")
+            ->capture_default_str()
+            ->check(CLI::PositiveNumber);
+        run_cmd.add_option("--bench-sample-time", bench_sample_time_ms,
+                           "Target duration of a benchmark sample in milliseconds")
+            ->capture_default_str()
+            ->check(CLI::Range(1, 60000));
+        run_cmd.add_option("--bench-report", bench_report_file,
+                           "Write the machine-readable benchmark report to the file");
+        run_cmd.add_option("--bench-format", bench_report_format, "Benchmark report format")
+            ->capture_default_str()
+            ->check(CLI::IsMember({"json", "csv"}));
+        run_cmd.add_flag("--bench-perf", bench_options.perf_counters,
+                         "Collect hardware performance counters during the benchmark (Linux only)");
+        run_cmd.add_flag("--bench-host-profile", bench_options.profile_host,
+                         "Count the host callbacks and measure the fraction of time spent in them");
+        run_cmd.add_flag("--bench-allocs", bench_options.track_allocations,
+                         "Count the heap allocations of the VM and of the host per execution "
+                         "(glibc only)");
+        run_cmd
+            .add_option("--bench-threads", bench_options.num_threads,
+                        "Number of threads executing concurrently in the scaling benchmark "
+                        "(the VM instance is shared and must be thread-safe)")
+            ->capture_default_str()
+            ->check(CLI::Range(1, 1024));
+        run_cmd
+            .add_option("--bench-cpus", bench_options.cpus,
+                        "Comma-separated list of CPUs to pin the scaling benchmark threads to")
+            ->delimiter(',')
+            ->check(CLI::NonNegativeNumber);
+        auto& record_option = *run_cmd.add_option(
+            "--record", record_file, "Record the host callbacks of the execution to the file");
+        auto& replay_option =
+            *run_cmd
+                 .add_option("--replay", replay_file,
+                             "Replay the host callbacks recorded with --record instead of using "
+                             "the mocked state")
+                 ->check(CLI::ExistingFile)
+                 ->excludes(&record_option);
+        run_cmd
+            .add_option("--state", state_file,
+                        "Initial accounts state: the JSON state or the binary snapshot "
+                        "(the code is executed in the account of the zero address)")
+            ->check(CLI::ExistingFile)
+            ->excludes(&replay_option);
+
+        auto& snapshot_cmd = *app.add_subcommand(
+            "snapshot", "Convert the JSON state to the binary snapshot for run --state");
+        snapshot_cmd.add_option("state", snapshot_in_file, "JSON state file")
+            ->required()
+            ->check(CLI::ExistingFile);
+        snapshot_cmd.add_option("output", snapshot_out_file, "Snapshot output file")->required();
+
+        auto& serve_cmd =
+            *app.add_subcommand("serve",
+                                "Execute the binary requests from the standard input on the warm "
+                                "VM and write the results to the standard output")
+                 ->fallthrough();
+        serve_cmd.add_option("--socket", socket_path,
+                             "Serve the connections to the Unix domain socket at the path instead");
+
+        auto& bench_cmd =
+            *app.add_subcommand("bench", "Benchmark a corpus of EVM bytecode cases on every VM")
+                 ->fallthrough();
+        bench_cmd
+            .add_option("corpus", corpus_dir,
+                        "Directory of NAME.hex bytecode files with optional NAME.input.hex inputs")
+            ->required()
+            ->check(CLI::ExistingDirectory);
+        bench_cmd.add_option("--gas", gas, "Execution gas limit")
+            ->capture_default_str()
+            ->check(CLI::Range(0, 1000000000));
+        bench_cmd.add_option("--rev", rev, "EVM revision")->capture_default_str();
+        bench_cmd
+            .add_option("--warmup", corpus_options.bench.warmup_iterations,
+                        "Number of warm-up executions")
+            ->capture_default_str()
+            ->check(CLI::NonNegativeNumber);
+        bench_cmd
+            .add_option("--samples", corpus_options.bench.num_samples, "Number of samples")
+            ->capture_default_str()
+            ->check(CLI::PositiveNumber);
+        bench_cmd
+            .add_option("--sample-time", bench_sample_time_ms,
+                        "Target duration of a sample in milliseconds")
+            ->capture_default_str()
+            ->check(CLI::Range(1, 60000));
+        bench_cmd
+            .add_option("--baseline", corpus_baseline_file,
+                        "Compare the results against the baseline JSON file")
+            ->check(CLI::ExistingFile);
+        bench_cmd.add_option("--save", corpus_save_file, "Save the results to the JSON file");
+        bench_cmd.add_flag("--diff", corpus_options.diff,
+                           "Compare the executions of every VM with the first VM");
+        bench_cmd
+            .add_option("--threshold", corpus_threshold_pct,
+                        "Slowdown against the baseline reported as regression, in percent")
+            ->capture_default_str()
+            ->check(CLI::Range(0.0, 1000.0));
 
         try
         {
             app.parse(argc, argv);
 
-            evmc::VM vm;
-            if (vm_option.count() != 0)
+            // The VMs are loaded once per process and shared by all executions.
+            std::vector<std::pair<std::string, VM>> vms;
+            for (const auto& vm_config : vm_configs)
             {
                 evmc_loader_error_code ec = EVMC_LOADER_UNSPECIFIED_ERROR;
-                vm = VM{evmc_load_and_configure(vm_config.c_str(), &ec)};
+                VM vm{evmc_load_and_configure(vm_config.c_str(), &ec)};
                 if (ec != EVMC_LOADER_SUCCESS)
                 {
                     const auto error = evmc_last_error_msg();
@@ -97,12 +237,13 @@ int main(int argc, const char** argv) noexcept
                         std::cerr << "Loading error " << ec << "\n";
                     return static_cast<int>(ec);
                 }
+                vms.emplace_back(vm_config, std::move(vm));
             }
 
             // Handle the --version flag first and exit when present.
             if (version_flag)
             {
-                if (vm)
+                for (const auto& [vm_config, vm] : vms)
                     std::cout << vm.name() << " " << vm.version() << " (" << vm_config << ")\n";
 
                 std::cout << "EVMC " PROJECT_VERSION;
@@ -117,13 +258,141 @@ int main(int argc, const char** argv) noexcept
                 // For run command the --vm is required.
                 if (vm_option.count() == 0)
                     throw CLI::RequiredError{vm_option.get_name()};
+                if (vms.size() > 2)
+                    throw CLI::ValidationError{vm_option.get_name(),
+                                               "run command requires one VM or two VMs to compare"};
+                const auto compare = vms.size() == 2;
+                auto& [vm_config, vm] = vms.front();
 
-                std::cout << "Config: " << vm_config << "\n";
+                if (compare)
+                {
+                    for (size_t i = 0; i < vms.size(); ++i)
+                        std::cout << "Config [" << (i + 1) << "]: " << vms[i].first << "\n";
+                }
+                else
+                    std::cout << "Config: " << vm_config << "\n";
 
                 // If code_arg or input_arg contains invalid hex string an exception is thrown.
-                const auto code = load_from_hex(code_arg);
-                const auto input = load_from_hex(input_arg);
-                return tooling::run(vm, rev, gas, code, input, create, bench, std::cout);
+                const BytesArg code{code_arg};
+                const BytesArg input{input_arg};
+
+                tooling::RunOptions run_options;
+                run_options.create = create;
+
+                std::optional<std::ofstream> report_file;
+                if (bench || compare)  // The VMs comparison always measures the time ratio.
+                {
+                    bench_options.sample_time = std::chrono::milliseconds{bench_sample_time_ms};
+                    if (bench_report_format == "csv")
+                        bench_options.report_format = tooling::ReportFormat::csv;
+                    if (!bench_report_file.empty())
+                    {
+                        report_file.emplace(bench_report_file);
+                        if (!*report_file)
+                            throw std::invalid_argument{"cannot open " + bench_report_file};
+                        bench_options.report = &*report_file;
+                    }
+                    run_options.bench = bench_options;
+                }
+
+                std::optional<std::ofstream> record_out;
+                if (!record_file.empty())
+                {
+                    record_out.emplace(record_file, std::ios::binary);
+                    if (!*record_out)
+                        throw std::invalid_argument{"cannot open " + record_file};
+                    run_options.record = &*record_out;
+                }
+
+                std::optional<tooling::ReplayHost> replay_host;
+                if (!replay_file.empty())
+                {
+                    std::ifstream replay_in{replay_file, std::ios::binary};
+                    replay_host.emplace(bytes{std::istreambuf_iterator<char>{replay_in},
+                                              std::istreambuf_iterator<char>{}});
+                    run_options.replay = &*replay_host;
+                }
+
+                tooling::State state;
+                if (!state_file.empty())
+                {
+                    state = tooling::load_state(state_file);
+                    run_options.state = &state;
+                }
+
+                if (compare)
+                {
+                    return tooling::run_diff(vm, vms[1].second, rev, gas, code.view(),
+                                             input.view(), run_options, std::cout);
+                }
+                return tooling::run(vm, rev, gas, code.view(), input.view(), run_options,
+                                    std::cout);
+            }
+
+            if (serve_cmd)
+            {
+                if (vm_option.count() == 0)
+                    throw CLI::RequiredError{vm_option.get_name()};
+                if (vms.size() != 1)
+                    throw CLI::ValidationError{vm_option.get_name(),
+                                               "serve command requires a single VM"};
+                auto& vm = vms.front().second;
+
+                if (!socket_path.empty())
+                {
+                    tooling::serve_unix_socket(vm, socket_path);
+                    return 0;
+                }
+
+                // The standard streams carry only the binary frames.
+                std::ios::sync_with_stdio(false);
+                tooling::serve(vm, std::cin, std::cout);
+                return 0;
+            }
+
+            if (snapshot_cmd)
+            {
+                const auto state = tooling::load_state(snapshot_in_file);
+                std::ofstream out{snapshot_out_file, std::ios::binary};
+                if (!out)
+                    throw std::invalid_argument{"cannot open " + snapshot_out_file};
+                tooling::write_state_snapshot(out, state);
+                size_t num_slots = 0;
+                for (const auto& [addr, account] : state)
+                    num_slots += account.storage.size();
+                std::cout << "Snapshot: " << state.size() << " accounts, " << num_slots
+                          << " storage slots\n";
+                return 0;
+            }
+
+            if (bench_cmd)
+            {
+                if (vm_option.count() == 0)
+                    throw CLI::RequiredError{vm_option.get_name()};
+
+                const auto cases = tooling::load_corpus(corpus_dir);
+                if (cases.empty())
+                    throw std::invalid_argument{"no *.hex cases in " + corpus_dir};
+
+                corpus_options.bench.sample_time = std::chrono::milliseconds{bench_sample_time_ms};
+                corpus_options.threshold = corpus_threshold_pct / 100;
+
+                std::optional<std::ifstream> baseline_file;
+                if (!corpus_baseline_file.empty())
+                {
+                    baseline_file.emplace(corpus_baseline_file);
+                    corpus_options.baseline = &*baseline_file;
+                }
+                std::optional<std::ofstream> save_file;
+                if (!corpus_save_file.empty())
+                {
+                    save_file.emplace(corpus_save_file);
+                    if (!*save_file)
+                        throw std::invalid_argument{"cannot open " + corpus_save_file};
+                    corpus_options.results = &*save_file;
+                }
+
+                return tooling::bench_corpus(vms, cases, rev, gas, corpus_options, std::cout);
             }
 
             return 0;